@@ -0,0 +1,344 @@
+// Per-branch cost of the CCurves functions, with a JSON dump and a comparison against an earlier one
+//
+//   curves-branch-bench [--count N] [--repeats N] [--json out.json] [--baseline base.json] [--threshold percent]
+//
+// Every case feeds its function only inputs that take one branch, so the numbers are the cost of that path with the
+// branch predicted. The mixed cases take random curves at random times instead, which is what traffic looks like
+// and where the branches mispredict. Returns 1 if a case got slower than the baseline by more than the threshold
+// (default 10%), 2 for bad options (a count of 0 included) or a baseline that can't be read or holds no cases.
+// Baselines only mean something on the machine (and build options) they were written with, keep one per machine
+// from a known-good build rather than checking one in.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "curve_inputs.hpp"
+#include "curves.hpp"
+
+namespace
+{
+struct BenchResult
+{
+    std::string name;
+    f64 ns;
+    f64 cycles;
+};
+
+// keeps the results alive so the calls can't be optimized away
+volatile f32 g_Sink;
+
+// Time stamp counter, 0 where there isn't one. Counts at the nominal clock, not the boosted one.
+u64 ReadCycles()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Random curves until `count` of them pass `accept`, which may also pick the Time that lands on its branch
+std::vector<CCurveInput> MakeInputs(u32 count, u32 seed, const std::function<bool(CCurveInput&)>& accept)
+{
+    std::vector<CCurveInput> inputs;
+    inputs.reserve(count);
+    for (u64 index = 0; inputs.size() < count; index++)
+    {
+        CCurveRandom random(seed, index);
+        CCurveInput in = MakePlainCurveInput(random);
+        if (accept(in))
+        {
+            inputs.push_back(in);
+        }
+    }
+    return inputs;
+}
+
+f32 StartDot(const CCurveInput& in)
+{
+    return in.startDir.x * in.endDir.x + in.startDir.y * in.endDir.y;
+}
+
+// Accepts crossing curves and moves Time into one of CalcCurvePoint's sections, 0/1/2 for first straight, bend and
+// second straight
+bool PickSection(CCurveInput& in, u32 section)
+{
+    const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    const f32 lengths[3] = {segment.StraightDist1, segment.BendDist, segment.StraightDist2};
+    if (!segment.bCrossing || lengths[section] < 0.5f)
+    {
+        return false;
+    }
+
+    // stay clear of the section ends, the compares there are < and >
+    const f32 from = section == 0 ? 0.0f : (section == 1 ? lengths[0] : lengths[0] + lengths[1]);
+    in.Time = (from + lengths[section] * (0.05f + in.Time * 0.9f)) / segment.TotalDist_Time;
+    return true;
+}
+
+template <typename Fn>
+BenchResult Bench(const char* name, const std::vector<CCurveInput>& inputs, u32 repeats, Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto Run = [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += fn(in);
+        }
+        g_Sink = sum;
+    };
+
+    Run();  // warm-up
+
+    f64 bestNs = 1e300;
+    f64 bestCycles = 1e300;
+    for (u32 r = 0; r < repeats; r++)
+    {
+        const auto start = Clock::now();
+        const u64 startCycles = ReadCycles();
+        Run();
+        const u64 endCycles = ReadCycles();
+        const auto end = Clock::now();
+
+        bestNs = std::min(bestNs, std::chrono::duration<f64, std::nano>(end - start).count());
+        bestCycles = std::min(bestCycles, static_cast<f64>(endCycles - startCycles));
+    }
+
+    const u32 calls = static_cast<u32>(inputs.size());
+    return {name, bestNs / calls, bestCycles / calls};
+}
+
+void WriteJson(const char* path, const std::vector<BenchResult>& results)
+{
+    std::ofstream file(path);
+    file << "{\n    \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        char line[256];
+        std::snprintf(line, sizeof(line), "        {\"name\": \"%s\", \"ns\": %.3f, \"cycles\": %.3f}%s\n",
+            results[i].name.c_str(), results[i].ns, results[i].cycles, i + 1 < results.size() ? "," : "");
+        file << line;
+    }
+    file << "    ]\n}\n";
+}
+
+// Reads the ns of every case from a file WriteJson made, it is not a general JSON parser. Empty if the file can't
+// be opened.
+std::map<std::string, f64> ReadBaseline(const char* path)
+{
+    std::map<std::string, f64> baseline;
+
+    std::ifstream file(path);
+    if (!file)
+    {
+        return baseline;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+
+    static constexpr char nameKey[] = "\"name\": \"";
+    static constexpr char nsKey[] = "\"ns\": ";
+    for (size_t pos = text.find(nameKey); pos != std::string::npos; pos = text.find(nameKey, pos))
+    {
+        pos += std::strlen(nameKey);
+        const size_t nameEnd = text.find('"', pos);
+        const size_t nsPos = text.find(nsKey, nameEnd);
+        if (nameEnd == std::string::npos || nsPos == std::string::npos)
+        {
+            break;
+        }
+        baseline[text.substr(pos, nameEnd - pos)] = std::strtod(text.c_str() + nsPos + std::strlen(nsKey), nullptr);
+    }
+    return baseline;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    u32 count = 4096;
+    u32 repeats = 200;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    f64 threshold = 10.0;
+
+    for (i32 i = 1; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            std::fprintf(stderr, "option %s needs a value\n", argv[i]);
+            return 2;
+        }
+
+        if (!std::strcmp(argv[i], "--count"))
+        {
+            count = static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (!std::strcmp(argv[i], "--repeats"))
+        {
+            repeats = static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (!std::strcmp(argv[i], "--json"))
+        {
+            jsonPath = argv[i + 1];
+        }
+        else if (!std::strcmp(argv[i], "--baseline"))
+        {
+            baselinePath = argv[i + 1];
+        }
+        else if (!std::strcmp(argv[i], "--threshold"))
+        {
+            threshold = std::strtod(argv[i + 1], nullptr);
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (count == 0)
+    {
+        std::fprintf(stderr, "--count needs at least one input\n");
+        return 2;
+    }
+
+    // read before the cases run, a check against a missing baseline would pass without comparing anything
+    std::map<std::string, f64> baseline;
+    if (baselinePath)
+    {
+        baseline = ReadBaseline(baselinePath);
+        if (baseline.empty())
+        {
+            std::fprintf(stderr, "no cases in baseline %s, or it can't be opened\n", baselinePath);
+            return 2;
+        }
+    }
+
+    const auto fallback = MakeInputs(count, 1, [](CCurveInput& in)
+    {
+        return !CCurveSegment(in.startCoors, in.endCoors, in.startDir, in.endDir).bCrossing;
+    });
+    const auto crossing = MakeInputs(count, 2, [](CCurveInput& in)
+    {
+        return CCurveSegment(in.startCoors, in.endCoors, in.startDir, in.endDir).bCrossing;
+    });
+    const auto parallel = MakeInputs(count, 3, [](CCurveInput& in)
+    {
+        in.endDir = in.startDir * -1.0f;
+        return true;
+    });
+    const auto dotBelowZero = MakeInputs(count, 4, [](CCurveInput& in) { return StartDot(in) <= 0.0f; });
+    const auto dotBelow07 =
+        MakeInputs(count, 5, [](CCurveInput& in) { return StartDot(in) > 0.0f && StartDot(in) <= 0.7f; });
+    const auto dotAbove07 = MakeInputs(count, 6, [](CCurveInput& in) { return StartDot(in) > 0.7f; });
+    const auto firstStraight = MakeInputs(count, 7, [](CCurveInput& in) { return PickSection(in, 0); });
+    const auto bend = MakeInputs(count, 8, [](CCurveInput& in) { return PickSection(in, 1); });
+    const auto secondStraight = MakeInputs(count, 9, [](CCurveInput& in) { return PickSection(in, 2); });
+    const auto mixed = MakeInputs(count, 10, [](CCurveInput&) { return true; });
+
+    const auto DistForLine = [](const CCurveInput& in)
+    {
+        return CCurves::DistForLineToCrossOtherLine(in.startCoors.x, in.startCoors.y, in.startDir.x, in.startDir.y,
+            in.endCoors.x, in.endCoors.y, in.endDir.x, in.endDir.y);
+    };
+    const auto SpeedVariation = [](const CCurveInput& in)
+    {
+        return CCurves::CalcSpeedVariationInBend(
+            in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+    };
+    const auto ScaleFactor = [](const CCurveInput& in)
+    {
+        return CCurves::CalcSpeedScaleFactor(
+            in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+    };
+    const auto CorrectedDist = [](f32 Total)
+    {
+        return [Total](const CCurveInput& in)
+        {
+            f32 interpol;
+            return CCurves::CalcCorrectedDist(in.Time * Total, Total, 0.2f, &interpol) + interpol;
+        };
+    };
+    const auto CurvePoint = [](const CCurveInput& in)
+    {
+        CVector resultCoor, resultSpeed;
+        CCurves::CalcCurvePoint(
+            in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+        return resultCoor.x + resultSpeed.x;
+    };
+    const auto CurvePointBranchless = [](const CCurveInput& in)
+    {
+        CVector resultCoor, resultSpeed;
+        CCurves::CalcCurvePointBranchless(
+            in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+        return resultCoor.x + resultSpeed.x;
+    };
+
+    std::vector<BenchResult> results;
+    results.push_back(Bench("DistForLineToCrossOtherLine/crossing", crossing, repeats, DistForLine));
+    results.push_back(Bench("DistForLineToCrossOtherLine/parallel", parallel, repeats, DistForLine));
+    results.push_back(Bench("CalcSpeedVariationInBend/dot<=0", dotBelowZero, repeats, SpeedVariation));
+    results.push_back(Bench("CalcSpeedVariationInBend/dot<=0.7", dotBelow07, repeats, SpeedVariation));
+    results.push_back(Bench("CalcSpeedVariationInBend/dot>0.7", dotAbove07, repeats, SpeedVariation));
+    results.push_back(Bench("CalcSpeedScaleFactor/crossing", crossing, repeats, ScaleFactor));
+    results.push_back(Bench("CalcSpeedScaleFactor/fallback", fallback, repeats, ScaleFactor));
+    results.push_back(Bench("CalcCorrectedDist/total>0", crossing, repeats, CorrectedDist(50.0f)));
+    results.push_back(Bench("CalcCorrectedDist/total=0", crossing, repeats, CorrectedDist(0.0f)));
+    results.push_back(Bench("CalcCurvePoint/fallback", fallback, repeats, CurvePoint));
+    results.push_back(Bench("CalcCurvePoint/first straight", firstStraight, repeats, CurvePoint));
+    results.push_back(Bench("CalcCurvePoint/bend", bend, repeats, CurvePoint));
+    results.push_back(Bench("CalcCurvePoint/second straight", secondStraight, repeats, CurvePoint));
+    results.push_back(Bench("CalcCurvePoint/mixed", mixed, repeats, CurvePoint));
+    results.push_back(Bench("CalcCurvePointBranchless/fallback", fallback, repeats, CurvePointBranchless));
+    results.push_back(Bench("CalcCurvePointBranchless/first straight", firstStraight, repeats, CurvePointBranchless));
+    results.push_back(Bench("CalcCurvePointBranchless/bend", bend, repeats, CurvePointBranchless));
+    results.push_back(Bench("CalcCurvePointBranchless/second straight", secondStraight, repeats, CurvePointBranchless));
+    results.push_back(Bench("CalcCurvePointBranchless/mixed", mixed, repeats, CurvePointBranchless));
+
+    std::printf("%u inputs per case, best of %u runs, cycles are time stamp counter ticks\n\n", count, repeats);
+    std::printf("%-40s %10s %12s %10s\n", "case", "ns/call", "cycles/call", "vs base");
+
+    bool bRegressed = false;
+    for (const BenchResult& result : results)
+    {
+        std::printf("%-40s %10.2f %12.1f", result.name.c_str(), result.ns, result.cycles);
+
+        const auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0.0)
+        {
+            const f64 change = (result.ns / it->second - 1.0) * 100.0;
+            const bool bSlower = change > threshold;
+            bRegressed |= bSlower;
+            std::printf(" %+9.1f%%%s", change, bSlower ? "  REGRESSION" : "");
+        }
+        std::printf("\n");
+    }
+
+    if (jsonPath)
+    {
+        WriteJson(jsonPath, results);
+    }
+
+    return bRegressed ? 1 : 0;
+}
@@ -0,0 +1,454 @@
+// Per-call cost of the CCurves functions, native custom implementation, no game needed
+//
+//   curves-bench [count] [repeats]
+//
+// Returns 2 for a count of 0.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "curve_arc_length.hpp"
+#include "curve_bvh.hpp"
+#include "curve_conflicts.hpp"
+#include "curve_cursor.hpp"
+#include "curve_inputs.hpp"
+#include "curve_math.hpp"
+#include "curve_route.hpp"
+#include "curve_stats.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// keeps the results alive so the calls can't be optimized away
+volatile f32 g_Sink;
+
+// Runs `fn` (which makes `calls` calls) a few times and reports the best ns/call
+template <typename Fn>
+void Bench(const char* name, u32 calls, u32 repeats, Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+
+    fn();  // warm-up
+
+    f64 best = 1e300;
+    for (u32 r = 0; r < repeats; r++)
+    {
+        const auto start = Clock::now();
+        fn();
+        const auto end = Clock::now();
+        best = std::min(best, std::chrono::duration<f64, std::nano>(end - start).count());
+    }
+
+    std::printf("%-40s %10.2f ns/call\n", name, best / calls);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const u32 count = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 1u << 16;
+    const u32 repeats = argc > 2 ? static_cast<u32>(std::strtoul(argv[2], nullptr, 10)) : 20;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "the count needs at least one curve\n");
+        return 2;
+    }
+
+    const std::vector<CCurveInput> inputs = MakePlainCurveInputs(count, 1337);
+
+    std::printf("%u curves, best of %u runs\n\n", count, repeats);
+
+    Bench("DistForLineToCrossOtherLine", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += CCurves::DistForLineToCrossOtherLine(in.startCoors.x, in.startCoors.y, in.startDir.x, in.startDir.y,
+                in.endCoors.x, in.endCoors.y, in.endDir.x, in.endDir.y);
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcSpeedVariationInBend", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += CCurves::CalcSpeedVariationInBend(
+                in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcSpeedScaleFactor", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += CCurves::CalcSpeedScaleFactor(
+                in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcCorrectedDist", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            f32 interpol;
+            sum += CCurves::CalcCorrectedDist(in.Time * 50.0f, 50.0f, 0.2f, &interpol) + interpol;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcCorrectedDistFast", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            f32 interpol;
+            sum += CCurves::CalcCorrectedDistFast(in.Time * 50.0f, 50.0f, 0.2f, &interpol) + interpol;
+        }
+        g_Sink = sum;
+    });
+
+    // CalcCorrectedDist's argument ranges, sin over [0, 2*PI] and cos over [0, PI]
+    Bench("CMaths::Sin + CMaths::Cos (libm)", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += CMaths::Sin(in.Time * TWO_PI) + CMaths::Cos(in.Time * PI);
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CMaths::FastSin + CMaths::FastCos", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            sum += CMaths::FastSin(in.Time * TWO_PI) + CMaths::FastCos(in.Time * PI);
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcCurvePoint", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            CVector resultCoor, resultSpeed;
+            CCurves::CalcCurvePoint(
+                in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x + resultSpeed.x;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CCurveMathT<CCurveExact>::CalcCurvePoint", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            CVector resultCoor, resultSpeed;
+            CCurveMathT<CCurveExact>::CalcCurvePoint(
+                in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x + resultSpeed.x;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CCurveMathT<CCurveFast>::CalcCurvePoint", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            CVector resultCoor, resultSpeed;
+            CCurveMathT<CCurveFast>::CalcCurvePoint(
+                in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x + resultSpeed.x;
+        }
+        g_Sink = sum;
+    });
+
+    // what the AI did before CalcCurveState
+    Bench("SpeedVariation + ScaleFactor + CurvePoint", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            CVector resultCoor, resultSpeed;
+            sum += CCurves::CalcSpeedVariationInBend(
+                in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+            sum += CCurves::CalcSpeedScaleFactor(
+                in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y);
+            CCurves::CalcCurvePoint(
+                in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x + resultSpeed.x;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("CalcCurveState", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveInput& in : inputs)
+        {
+            CCurveState state;
+            CCurves::CalcCurveState(in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, state);
+            sum += state.SpeedVariation + state.SpeedScaleFactor + state.Coors.x + state.Speed.x;
+        }
+        g_Sink = sum;
+    });
+
+    std::vector<CCurveSegment> segments;
+    segments.reserve(count);
+    for (const CCurveInput& in : inputs)
+    {
+        segments.emplace_back(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    }
+
+    Bench("CalcCurvePoint (CCurveSegment)", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 i = 0; i < count; i++)
+        {
+            CVector resultCoor, resultSpeed;
+            CCurves::CalcCurvePoint(segments[i], inputs[i].Time, 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x + resultSpeed.x;
+        }
+        g_Sink = sum;
+    });
+
+    // 60 steps of a 1 second traversal per curve
+    Bench("CCurveCursor::Advance", count * 60, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (const CCurveSegment& segment : segments)
+        {
+            CCurveCursor cursor(segment, 1000);
+            for (u32 step = 0; step < 60; step++)
+            {
+                cursor.Advance(1000.0f / 60.0f);
+                sum += cursor.GetPosition().x + cursor.GetSpeed().x;
+            }
+        }
+        g_Sink = sum;
+    });
+
+    // curve lengths, summing the chords of sampled points (as CCurveArcLength does) against CalcCurveLengths
+    const u32 numSampledLengths = std::max(count / 64, 1u);
+    Bench("curve length (256 samples)", numSampledLengths, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 i = 0; i < numSampledLengths; i++)
+        {
+            sum += CCurveArcLength(segments[i]).Length;
+        }
+        g_Sink = sum;
+    });
+
+    std::vector<f32> lengths(count);
+    Bench("curve length (CalcCurveLengths)", count, repeats, [&]
+    {
+        CCurves::CalcCurveLengths(segments.data(), count, lengths.data());
+        g_Sink = lengths[count / 2];
+    });
+
+    // closest point on a curve to a point next to it, the 32-sample search the AI used against the solver
+    Bench("closest point (32 samples)", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 i = 0; i < count; i++)
+        {
+            const CVector point = inputs[i].startCoors + CVector(3.0f, -2.0f, 0.0f);
+            f32 bestTime = 0.0f;
+            f32 bestDist = 3.4e38f;
+            for (u32 k = 0; k <= 32; k++)
+            {
+                CVector resultCoor, resultSpeed;
+                CCurves::CalcCurvePoint(segments[i], static_cast<f32>(k) / 32.0f, 1000, resultCoor, resultSpeed);
+                const f32 dist = (resultCoor - point).Magnitude();
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    bestTime = static_cast<f32>(k) / 32.0f;
+                }
+            }
+            sum += bestTime;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("closest point (FindClosestTime)", count, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 i = 0; i < count; i++)
+        {
+            CVector closest;
+            sum += CCurves::FindClosestTime(segments[i], inputs[i].startCoors + CVector(3.0f, -2.0f, 0.0f), closest);
+        }
+        g_Sink = sum;
+    });
+
+    // nearest curve to points around the curves, brute force against the BVH
+    const u32 numQueries = std::min(count, 1024u);
+    const u32 numBruteForce = std::max(numQueries / 64, 1u);
+
+    Bench("nearest curve (brute force)", numBruteForce, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 q = 0; q < numBruteForce; q++)
+        {
+            const CVector point = inputs[q].startCoors + CVector(3.0f, -2.0f, 0.0f);
+            f32 best = 3.4e38f;
+            for (const CCurveSegment& segment : segments)
+            {
+                best = std::min(best, CCurveBVH::DistToCurve(segment, point));
+            }
+            sum += best;
+        }
+        g_Sink = sum;
+    });
+
+    const CCurveBVH bvh(segments.data(), count);
+
+    Bench("nearest curve (CCurveBVH)", numQueries, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 q = 0; q < numQueries; q++)
+        {
+            f32 dist = 0.0f;
+            bvh.FindNearest(inputs[q].startCoors + CVector(3.0f, -2.0f, 0.0f), 1e6f, &dist);
+            sum += dist;
+        }
+        g_Sink = sum;
+    });
+
+    // conflicts between agents on the curves pulled into a 10th of the area, like traffic around junctions
+    const u32 numAgents = std::min(count, 4096u);
+    std::vector<CCurveSegment> agentSegments;
+    std::vector<CCurveAgent> agents;
+    agentSegments.reserve(numAgents);
+    for (u32 i = 0; i < numAgents; i++)
+    {
+        const CCurveInput& in = inputs[i];
+        const CVector startCoors = in.startCoors * 0.1f;
+        agentSegments.emplace_back(startCoors, startCoors + (in.endCoors - in.startCoors), in.startDir, in.endDir);
+        agents.push_back({&agentSegments[i], in.Time, 3000, 2.0f});
+    }
+    const u32 numBruteForceAgents = std::min(numAgents, 512u);
+
+    Bench("conflicts per agent (brute force)", numBruteForceAgents, repeats, [&]
+    {
+        u32 numConflicts = 0;
+        for (u32 a = 0; a < numBruteForceAgents; a++)
+        {
+            for (u32 b = a + 1; b < numBruteForceAgents; b++)
+            {
+                CCurveConflict conflict;
+                numConflicts += CCurveConflicts::CalcClosestApproach(agents[a], agents[b], 1000.0f, conflict);
+            }
+        }
+        g_Sink = static_cast<f32>(numConflicts);
+    });
+
+    CCurveConflicts conflicts;
+    Bench("conflicts per agent (CCurveConflicts)", numAgents, repeats, [&]
+    {
+        conflicts.Update(agents.data(), numAgents, 1000.0f);
+        g_Sink = static_cast<f32>(conflicts.GetNumConflicts());
+    });
+
+    // point at a distance along a route of all the curves, walking it against the prefix sums
+    const u32 numRouteCurves = std::min(count, 4096u);
+    CCurveRoute route;
+    for (u32 i = 0; i < numRouteCurves; i++)
+    {
+        route.PushBack(segments[i], 1000);
+    }
+    const f32 routeLength = route.GetLength();
+
+    Bench("route point at distance (walk)", numQueries, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 q = 0; q < numQueries; q++)
+        {
+            f32 dist = routeLength * inputs[q].Time;
+            u32 i = 0;
+            for (f32 length; i + 1 < numRouteCurves && dist > (length = CCurves::CalcSpeedScaleFactor(segments[i]));
+                 i++)
+            {
+                dist -= length;
+            }
+
+            CVector resultCoor, resultSpeed;
+            CCurves::CalcCurvePoint(
+                segments[i], dist / CCurves::CalcSpeedScaleFactor(segments[i]), 1000, resultCoor, resultSpeed);
+            sum += resultCoor.x;
+        }
+        g_Sink = sum;
+    });
+
+    Bench("route point at distance (CCurveRoute)", numQueries, repeats, [&]
+    {
+        f32 sum = 0.0f;
+        for (u32 q = 0; q < numQueries; q++)
+        {
+            CVector resultCoor, resultSpeed;
+            route.CalcPointAtDist(routeLength * inputs[q].Time, resultCoor, resultSpeed);
+            sum += resultCoor.x;
+        }
+        g_Sink = sum;
+    });
+
+    // structure-of-arrays copy of the same inputs
+    std::vector<f32> soa[13];
+    std::vector<i32> traversal(count, 1000);
+    for (std::vector<f32>& v : soa)
+    {
+        v.resize(count);
+    }
+    for (u32 i = 0; i < count; i++)
+    {
+        const CCurveInput& in = inputs[i];
+        const f32 values[] = {in.startCoors.x, in.startCoors.y, in.startCoors.z, in.endCoors.x, in.endCoors.y,
+            in.endCoors.z, in.startDir.x, in.startDir.y, in.startDir.z, in.endDir.x, in.endDir.y, in.endDir.z, in.Time};
+        for (u32 k = 0; k < 13; k++)
+        {
+            soa[k][i] = values[k];
+        }
+    }
+
+    std::vector<f32> out[6];
+    for (std::vector<f32>& v : out)
+    {
+        v.resize(count);
+    }
+
+    const CCurveBatch batch = {soa[0].data(), soa[1].data(), soa[2].data(), soa[3].data(), soa[4].data(),
+        soa[5].data(), soa[6].data(), soa[7].data(), soa[8].data(), soa[9].data(), soa[10].data(), soa[11].data(),
+        soa[12].data(), traversal.data()};
+    const CCurveBatchResult batchResult = {
+        out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data(), out[5].data()};
+
+    Bench("CalcCurvePoints (batch)", count, repeats, [&]
+    {
+        CCurves::CalcCurvePoints(batch, count, batchResult);
+        g_Sink = out[0][count / 2];
+    });
+
+#ifdef CURVES_STATS
+    // the timings above include the counting, the point of this build is what the inputs made the functions do
+    std::printf("\n");
+    CCurveStats::Dump(stdout);
+#endif
+
+    return 0;
+}
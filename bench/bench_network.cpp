@@ -0,0 +1,136 @@
+// Load throughput of CCurveNetwork over the thread count
+//
+//   curves-network-bench [--nodes N] [--file path] [--repeats N] [--threads N]
+//
+// Without --file a synthetic node file of --nodes nodes is written to the temp directory and removed afterwards.
+// Every load maps the file and builds all curves and lengths, the first one runs on a cold mapping and is the
+// warm-up, the best of the others is reported (the file stays in the page cache between them). Returns 2 for bad
+// options.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "curve_network.hpp"
+#include "curve_thread_pool.hpp"
+#include "curves.hpp"
+
+namespace
+{
+// keeps the results alive so the loads can't be optimized away
+volatile f32 g_Sink;
+
+f64 TimeLoad(CCurveNetwork& network, const char* pPath, CCurveThreadPool* pPool, u32 repeats)
+{
+    using Clock = std::chrono::steady_clock;
+
+    f64 best = 1e300;
+    for (u32 r = 0; r <= repeats; r++)
+    {
+        const auto start = Clock::now();
+        if (!network.Load(pPath, pPool))
+        {
+            std::fprintf(stderr, "can't load %s\n", pPath);
+            std::exit(1);
+        }
+        const f64 ms = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+        best = r > 0 ? std::min(best, ms) : best;
+        g_Sink = network.GetLength(network.GetNumLinks() / 2);
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    u32 numNodes = 1u << 20;
+    u32 repeats = 5;
+    u32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string path;
+    for (i32 i = 1; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            std::fprintf(stderr, "option %s needs a value\n", argv[i]);
+            return 2;
+        }
+
+        if (std::strcmp(argv[i], "--nodes") == 0)
+        {
+            numNodes = static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--file") == 0)
+        {
+            path = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--repeats") == 0)
+        {
+            repeats = std::max(1u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0)
+        {
+            maxThreads = std::max(1u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)));
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    const bool bSynthetic = path.empty();
+    if (bSynthetic)
+    {
+        path = (std::filesystem::temp_directory_path() / "curves_network_bench.bin").string();
+
+        const auto start = std::chrono::steady_clock::now();
+        if (!CCurveNetwork::WriteSyntheticNodeFile(path.c_str(), numNodes, 1337))
+        {
+            std::fprintf(stderr, "can't write %s\n", path.c_str());
+            return 1;
+        }
+        const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("wrote %u synthetic nodes in %.1f ms\n", numNodes, ms);
+    }
+
+    CCurveNetwork network;
+    const f64 serial = TimeLoad(network, path.c_str(), nullptr, repeats);
+    const u32 numLinks = network.GetNumLinks();
+    const f64 fileMiB = static_cast<f64>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    u32 numCrossing = 0;
+    for (u32 i = 0; i < numLinks; i++)
+    {
+        numCrossing += network.GetCurve(i).bCrossing;
+    }
+
+    std::printf("%s: %u nodes, %u links (%.1f%% crossing), %.1f MiB, best of %u loads\n\n", path.c_str(),
+        network.GetNumNodes(), numLinks, 100.0 * numCrossing / std::max(numLinks, 1u), fileMiB, repeats);
+    std::printf("%8s %12s %14s %12s %10s\n", "threads", "ms", "Mlinks/s", "MiB/s", "speedup");
+
+    const auto Print = [&](const char* pThreads, f64 ms)
+    {
+        std::printf("%8s %12.2f %14.2f %12.1f %10.2f\n", pThreads, ms, numLinks / ms * 1e-3, fileMiB / ms * 1e3,
+            serial / ms);
+    };
+    Print("no pool", serial);
+
+    for (u32 numThreads = 1; numThreads <= maxThreads; numThreads++)
+    {
+        CCurveThreadPool pool(numThreads);
+        const std::string threads = std::to_string(numThreads);
+        Print(threads.c_str(), TimeLoad(network, path.c_str(), &pool, repeats));
+    }
+
+    network.Clear();
+    if (bSynthetic)
+    {
+        std::filesystem::remove(path);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Scaling of CCurveThreadPool::CalcCurvePoints over the thread count
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "curve_inputs.hpp"
+#include "curve_thread_pool.hpp"
+#include "curves.hpp"
+
+namespace
+{
+// keeps the results alive so the calls can't be optimized away
+volatile f32 g_Sink;
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const u32 count = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 1u << 20;
+    const u32 repeats = argc > 2 ? static_cast<u32>(std::strtoul(argv[2], nullptr, 10)) : 10;
+    const u32 hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const u32 maxThreads = argc > 3 ? static_cast<u32>(std::strtoul(argv[3], nullptr, 10)) : hardwareThreads;
+
+    std::vector<f32> in[13];
+    std::vector<i32> traversal(count, 1000);
+    std::vector<f32> out[6];
+    for (std::vector<f32>& v : in)
+    {
+        v.resize(count);
+    }
+    for (std::vector<f32>& v : out)
+    {
+        v.resize(count);
+    }
+
+    for (u32 i = 0; i < count; i++)
+    {
+        CCurveRandom random(1337, i);
+        const CCurveInput curve = MakePlainCurveInput(random);
+
+        const CVector* vectors[4] = {&curve.startCoors, &curve.endCoors, &curve.startDir, &curve.endDir};
+        for (u32 v = 0; v < 4; v++)
+        {
+            in[v * 3 + 0][i] = vectors[v]->x;
+            in[v * 3 + 1][i] = vectors[v]->y;
+            in[v * 3 + 2][i] = vectors[v]->z;
+        }
+        in[12][i] = curve.Time;
+    }
+
+    const CCurveBatch batch = {in[0].data(), in[1].data(), in[2].data(), in[3].data(), in[4].data(), in[5].data(),
+        in[6].data(), in[7].data(), in[8].data(), in[9].data(), in[10].data(), in[11].data(), in[12].data(),
+        traversal.data()};
+    const CCurveBatchResult result = {
+        out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data(), out[5].data()};
+
+    std::printf("%u curves, best of %u runs, %u hardware threads\n\n", count, repeats, hardwareThreads);
+    std::printf("%8s %14s %10s %12s\n", "threads", "ns/curve", "speedup", "efficiency");
+
+    f64 serial = 0.0;
+    for (u32 numThreads = 1; numThreads <= maxThreads; numThreads++)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        CCurveThreadPool pool(numThreads);
+        pool.CalcCurvePoints(batch, count, result);  // warm-up
+
+        f64 best = 1e300;
+        for (u32 r = 0; r < repeats; r++)
+        {
+            const auto start = Clock::now();
+            pool.CalcCurvePoints(batch, count, result);
+            const auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<f64, std::nano>(end - start).count());
+        }
+        g_Sink = out[0][count / 2];
+
+        if (numThreads == 1)
+        {
+            serial = best;
+        }
+        std::printf("%8u %14.3f %9.2fx %11.0f%%\n", numThreads, best / count, serial / best,
+            100.0 * serial / best / numThreads);
+    }
+
+    return 0;
+}
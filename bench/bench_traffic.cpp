@@ -0,0 +1,306 @@
+// Frame times of a synthetic traffic load, agents driving a road network along its curves
+//
+//   curves-traffic-bench [--agents N] [--threads N] [--frames N] [--nodes N] [--seed N]
+//
+// The roads are a CCurveNetwork synthetic node file, every link driven both ways. Each simulated frame every agent
+// moves along its road by the frame time and gets its position and speed from CalcCurvePoint, and on reaching the
+// end of a road picks a random next one at the end node and times it with CalcSpeedScaleFactor, the way the game
+// sets up a car's next link. Without --agents it runs 1k, 10k and 100k agents, without --threads every count up to
+// the hardware threads.
+//
+// Everything comes from the seed, agents have their own CCurveRandom state, so the checksum of the final agent
+// states is the same for every thread count and run. Frames are timed one by one after a warm-up and reported as
+// p50 / p99 / max, plus the curve function calls per second over all of them. Returns 2 for bad options.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "curve_inputs.hpp"
+#include "curve_network.hpp"
+#include "curve_thread_pool.hpp"
+#include "curves.hpp"
+
+namespace
+{
+constexpr f32 FRAME_MILLIS = 1000.0f / 30.0f;
+constexpr u32 WARMUP_FRAMES = 30;
+constexpr u32 AGENTS_PER_CHUNK = 1024;
+
+// a link of the network driven one way
+struct CRoad
+{
+    CVector StartCoors;
+    CVector EndCoors;
+    CVector StartDir;
+    CVector EndDir;
+    u32 EndNode;
+};
+
+struct CRoadGraph
+{
+    std::vector<CRoad> Roads;    // link i forwards at 2 * i, backwards at 2 * i + 1
+    std::vector<u32> FirstRoad;  // roads leaving node n are NodeRoads[FirstRoad[n] .. FirstRoad[n + 1])
+    std::vector<u32> NodeRoads;
+};
+
+struct CAgent
+{
+    u32 Road;
+    f32 Time;
+    i32 TraverselTimeInMillis;
+    f32 CruiseSpeed;  // units per second
+    CCurveRandom Random;
+    CVector Coors;
+    CVector Speed;
+};
+
+struct CFrameJob
+{
+    const CRoadGraph* pGraph;
+    CAgent* pAgents;
+    u32 NumAgents;
+    std::atomic<u64> NumEvaluations;
+};
+
+CRoadGraph BuildGraph(const CCurveNetwork& network)
+{
+    CRoadGraph graph;
+    graph.Roads.resize(network.GetNumLinks() * 2);
+    graph.FirstRoad.assign(network.GetNumNodes() + 1, 0);
+
+    for (u32 i = 0; i < network.GetNumLinks(); i++)
+    {
+        const CCurveNetwork::CLink& link = network.GetLink(i);
+        const CVector& startCoors = network.GetNode(link.StartNode);
+        const CVector& endCoors = network.GetNode(link.EndNode);
+        const CVector startDir(link.StartDirX, link.StartDirY, 0.0f);
+        const CVector endDir(link.EndDirX, link.EndDirY, 0.0f);
+
+        graph.Roads[2 * i] = {startCoors, endCoors, startDir, endDir, link.EndNode};
+        graph.Roads[2 * i + 1] = {endCoors, startCoors, endDir * -1.0f, startDir * -1.0f, link.StartNode};
+        graph.FirstRoad[link.StartNode + 1]++;
+        graph.FirstRoad[link.EndNode + 1]++;
+    }
+
+    for (u32 n = 0; n < network.GetNumNodes(); n++)
+    {
+        graph.FirstRoad[n + 1] += graph.FirstRoad[n];
+    }
+
+    graph.NodeRoads.resize(graph.Roads.size());
+    std::vector<u32> fill(graph.FirstRoad.begin(), graph.FirstRoad.end() - 1);
+    for (u32 i = 0; i < network.GetNumLinks(); i++)
+    {
+        const CCurveNetwork::CLink& link = network.GetLink(i);
+        graph.NodeRoads[fill[link.StartNode]++] = 2 * i;
+        graph.NodeRoads[fill[link.EndNode]++] = 2 * i + 1;
+    }
+    return graph;
+}
+
+// Puts the agent at the start of a road and times it by its speed scale factor, like the game does for a new link
+void SetRoad(const CRoadGraph& graph, CAgent& agent, u32 Road)
+{
+    const CRoad& road = graph.Roads[Road];
+    const f32 scale = CCurves::CalcSpeedScaleFactor(
+        road.StartCoors, road.EndCoors, road.StartDir.x, road.StartDir.y, road.EndDir.x, road.EndDir.y);
+
+    agent.Road = Road;
+    agent.TraverselTimeInMillis = std::max(1, static_cast<i32>(scale / agent.CruiseSpeed * 1000.0f));
+}
+
+// A random road out of the end node, not straight back unless it's a dead end
+void EnterNextRoad(const CRoadGraph& graph, CAgent& agent)
+{
+    const u32 node = graph.Roads[agent.Road].EndNode;
+    const u32 first = graph.FirstRoad[node];
+    const u32 count = graph.FirstRoad[node + 1] - first;
+
+    u32 pick = agent.Random.NextInt(count);
+    if ((graph.NodeRoads[first + pick] ^ 1) == agent.Road && count > 1)
+    {
+        pick = (pick + 1) % count;
+    }
+    SetRoad(graph, agent, graph.NodeRoads[first + pick]);
+}
+
+void StepChunk(void* pContext, u32 Chunk)
+{
+    CFrameJob& job = *static_cast<CFrameJob*>(pContext);
+    const CRoadGraph& graph = *job.pGraph;
+    const u32 begin = Chunk * AGENTS_PER_CHUNK;
+    const u32 end = std::min(begin + AGENTS_PER_CHUNK, job.NumAgents);
+
+    u64 numEvaluations = 0;
+    for (u32 i = begin; i < end; i++)
+    {
+        CAgent& agent = job.pAgents[i];
+
+        agent.Time += FRAME_MILLIS / static_cast<f32>(agent.TraverselTimeInMillis);
+        if (agent.Time >= 1.0f)
+        {
+            // carry the time left over into the next road
+            const f32 leftMillis = (agent.Time - 1.0f) * static_cast<f32>(agent.TraverselTimeInMillis);
+            EnterNextRoad(graph, agent);
+            agent.Time = std::min(leftMillis / static_cast<f32>(agent.TraverselTimeInMillis), 1.0f);
+            numEvaluations++;
+        }
+
+        const CRoad& road = graph.Roads[agent.Road];
+        CCurves::CalcCurvePoint(road.StartCoors, road.EndCoors, road.StartDir, road.EndDir, agent.Time,
+            agent.TraverselTimeInMillis, agent.Coors, agent.Speed);
+        numEvaluations++;
+    }
+    job.NumEvaluations.fetch_add(numEvaluations, std::memory_order_relaxed);
+}
+
+std::vector<CAgent> SpawnAgents(const CRoadGraph& graph, u32 NumAgents, u64 Seed)
+{
+    std::vector<CAgent> agents;
+    agents.reserve(NumAgents);
+    for (u32 i = 0; i < NumAgents; i++)
+    {
+        CCurveRandom random(Seed, i);
+        const f32 cruiseSpeed = random.Next(10.0f, 25.0f);
+        const u32 road = random.NextInt(static_cast<u32>(graph.Roads.size()));
+        const f32 time = random.Next(0.0f, 1.0f);
+
+        CAgent& agent = agents.emplace_back(CAgent{0, time, 1, cruiseSpeed, random, CVector(), CVector()});
+        SetRoad(graph, agent, road);
+    }
+    return agents;
+}
+
+// FNV-1a over the bits of every agent's road and position
+u64 Checksum(const std::vector<CAgent>& agents)
+{
+    u64 hash = 0xCBF29CE484222325ull;
+    for (const CAgent& agent : agents)
+    {
+        u32 words[4] = {agent.Road};
+        std::memcpy(&words[1], &agent.Coors, sizeof(CVector));
+        for (const u32 word : words)
+        {
+            hash = (hash ^ word) * 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+f64 Percentile(const std::vector<f64>& sorted, f64 p)
+{
+    return sorted[static_cast<size_t>(p * static_cast<f64>(sorted.size() - 1))];
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<u32> agentCounts = {1000, 10000, 100000};
+    u32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    u32 minThreads = 1;
+    u32 numFrames = 300;
+    u32 numNodes = 40000;
+    u64 seed = 1337;
+    for (i32 i = 1; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            std::fprintf(stderr, "option %s needs a value\n", argv[i]);
+            return 2;
+        }
+
+        if (!std::strcmp(argv[i], "--agents"))
+        {
+            agentCounts = {std::max(1u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)))};
+        }
+        else if (!std::strcmp(argv[i], "--threads"))
+        {
+            minThreads = maxThreads = std::max(1u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)));
+        }
+        else if (!std::strcmp(argv[i], "--frames"))
+        {
+            numFrames = std::max(1u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)));
+        }
+        else if (!std::strcmp(argv[i], "--nodes"))
+        {
+            numNodes = std::max(4u, static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10)));
+        }
+        else if (!std::strcmp(argv[i], "--seed"))
+        {
+            seed = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "curves_traffic_bench.bin").string();
+    CCurveNetwork network;
+    if (!CCurveNetwork::WriteSyntheticNodeFile(path.c_str(), numNodes, seed) || !network.Load(path.c_str()))
+    {
+        std::fprintf(stderr, "can't write or load %s\n", path.c_str());
+        return 1;
+    }
+    const CRoadGraph graph = BuildGraph(network);
+    network.Clear();
+    std::filesystem::remove(path);
+
+    std::printf("%u nodes, %zu roads, seed %llu, %u frames of %.1f ms after %u warm-up frames\n\n", numNodes,
+        graph.Roads.size(), static_cast<unsigned long long>(seed), numFrames, FRAME_MILLIS, WARMUP_FRAMES);
+    std::printf("%8s %8s %10s %10s %10s %12s %10s %18s\n", "agents", "threads", "p50 ms", "p99 ms", "max ms",
+        "Mevals/s", "speedup", "checksum");
+
+    for (const u32 numAgents : agentCounts)
+    {
+        f64 serial = 0.0;
+        for (u32 numThreads = minThreads; numThreads <= maxThreads; numThreads++)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            CCurveThreadPool pool(numThreads);
+            std::vector<CAgent> agents = SpawnAgents(graph, numAgents, seed);
+            CFrameJob job = {&graph, agents.data(), numAgents, 0};
+            const u32 numChunks = (numAgents + AGENTS_PER_CHUNK - 1) / AGENTS_PER_CHUNK;
+
+            for (u32 frame = 0; frame < WARMUP_FRAMES; frame++)
+            {
+                pool.Run(numChunks, StepChunk, &job);
+            }
+            job.NumEvaluations = 0;
+
+            std::vector<f64> frameMillis(numFrames);
+            for (u32 frame = 0; frame < numFrames; frame++)
+            {
+                const auto start = Clock::now();
+                pool.Run(numChunks, StepChunk, &job);
+                frameMillis[frame] = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+            }
+
+            f64 totalMillis = 0.0;
+            for (const f64 millis : frameMillis)
+            {
+                totalMillis += millis;
+            }
+            std::sort(frameMillis.begin(), frameMillis.end());
+
+            const f64 p50 = Percentile(frameMillis, 0.5);
+            serial = numThreads == minThreads ? p50 : serial;
+            std::printf("%8u %8u %10.3f %10.3f %10.3f %12.2f %9.2fx %18llx\n", numAgents, numThreads, p50,
+                Percentile(frameMillis, 0.99), frameMillis.back(), job.NumEvaluations.load() / totalMillis * 1e-3,
+                serial / p50, static_cast<unsigned long long>(Checksum(agents)));
+        }
+    }
+
+    return 0;
+}
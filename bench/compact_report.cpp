@@ -0,0 +1,188 @@
+// Memory, quantization error and sweep time of CCompactCurve against full curves
+//
+//   curves-compact-report [count]
+//
+// The curves are random links like the other tools make, with unit directions (CCompactCurve normalizes them, any
+// other length would count as error). Point errors are the 3D distance between CalcCurvePoint on the encoded curve
+// and on the original one, relative ones are to the original value. Curves the rounding flips between the crossing
+// and the fallback path are only counted.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "curve_compact.hpp"
+#include "curve_inputs.hpp"
+#include "curves.hpp"
+
+namespace
+{
+// keeps the results alive so the calls can't be optimized away
+volatile f32 g_Sink;
+
+// from the cross product, acos of the dot product loses small angles to the rounding of the lengths
+f64 Angle(const CVector& a, const CVector& b)
+{
+    const f64 dot = static_cast<f64>(a.x) * b.x + static_cast<f64>(a.y) * b.y + static_cast<f64>(a.z) * b.z;
+    const f64 crossX = static_cast<f64>(a.y) * b.z - static_cast<f64>(a.z) * b.y;
+    const f64 crossY = static_cast<f64>(a.z) * b.x - static_cast<f64>(a.x) * b.z;
+    const f64 crossZ = static_cast<f64>(a.x) * b.y - static_cast<f64>(a.y) * b.x;
+    return std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot);
+}
+
+// largest value and the 99th / 99.9th percentile
+struct CErrors
+{
+    const char* Name;
+    std::vector<f64> Values = {};
+
+    void Print()
+    {
+        std::sort(Values.begin(), Values.end());
+        const auto Percentile = [this](f64 p) { return Values[static_cast<size_t>(p * (Values.size() - 1))]; };
+        std::printf("%-36s %12.3g %12.3g %12.3g\n", Name, Percentile(0.99), Percentile(0.999), Values.back());
+    }
+};
+
+template <typename Fn>
+f64 BestOf(u32 repeats, Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+
+    fn();  // warm-up
+    f64 best = 1e300;
+    for (u32 r = 0; r < repeats; r++)
+    {
+        const auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const u32 count = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 50000;
+
+    const std::vector<CCurveInput> inputs = MakePlainCurveInputs(count, 1337);
+    const CVector origin(0.0f, 0.0f, 0.0f);
+
+    std::vector<CCompactCurve> compact(count);
+    for (u32 i = 0; i < count; i++)
+    {
+        const CCurveInput& in = inputs[i];
+        compact[i] = CCompactCurve(origin, in.startCoors, in.endCoors, in.startDir, in.endDir);
+    }
+
+    std::printf("%u random curves\n\n", count);
+    std::printf("%-36s %12s %12s\n", "memory", "bytes/curve", "total KiB");
+    const std::pair<const char*, size_t> sizes[] = {
+        {"4 x CVector", 4 * sizeof(CVector)},
+        {"CCurveSegment", sizeof(CCurveSegment)},
+        {"CCompactCurve", sizeof(CCompactCurve)},
+    };
+    for (const auto& [name, size] : sizes)
+    {
+        std::printf("%-36s %12zu %12.1f\n", name, size, static_cast<f64>(size) * count / 1024.0);
+    }
+
+    CErrors coorError{"coordinates (units)"};
+    CErrors dirError{"directions (rad)"};
+    CErrors pointError{"CalcCurvePoint (units)"};
+    CErrors speedError{"CalcCurvePoint speed (relative)"};
+    CErrors scaleError{"CalcSpeedScaleFactor (relative)"};
+    u32 flipped = 0;
+
+    for (u32 i = 0; i < count; i++)
+    {
+        const CCurveInput& in = inputs[i];
+        CVector startCoors, endCoors, startDir, endDir;
+        compact[i].Decode(origin, startCoors, endCoors, startDir, endDir);
+
+        for (const auto& [decoded, original] : {std::pair(startCoors, in.startCoors), std::pair(endCoors, in.endCoors)})
+        {
+            coorError.Values.push_back(std::fabs(decoded.x - original.x));
+            coorError.Values.push_back(std::fabs(decoded.y - original.y));
+            coorError.Values.push_back(std::fabs(decoded.z - original.z));
+        }
+        dirError.Values.push_back(Angle(startDir, in.startDir));
+        dirError.Values.push_back(Angle(endDir, in.endDir));
+
+        // nearly parallel rays can cross on one side of the rounding and not on the other, a different path
+        const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+        if (compact[i].ToSegment(origin).bCrossing != segment.bCrossing)
+        {
+            flipped++;
+            continue;
+        }
+
+        CVector coor, speed, compactCoor, compactSpeed;
+        CCurves::CalcCurvePoint(segment, in.Time, 1000, coor, speed);
+        compact[i].CalcCurvePoint(origin, in.Time, 1000, compactCoor, compactSpeed);
+
+        const f32 scale = CCurves::CalcSpeedScaleFactor(segment);
+        pointError.Values.push_back((compactCoor - coor).Magnitude());
+        speedError.Values.push_back((compactSpeed - speed).Magnitude() / std::max(speed.Magnitude(), 1e-3f));
+        scaleError.Values.push_back(std::fabs(compact[i].CalcSpeedScaleFactor(origin) - scale) / scale);
+    }
+
+    std::printf("\n%-36s %12s %12s %12s\n", "error", "p99", "p99.9", "max");
+    for (CErrors* errors : {&coorError, &dirError, &pointError, &speedError, &scaleError})
+    {
+        errors->Print();
+    }
+    std::printf("crossing / fallback flipped by the rounding: %u\n", flipped);
+
+    // the per-frame sweep, CalcCurvePoints over every curve from the full SoA arrays or the compact records
+    std::vector<f32> full[12];
+    for (std::vector<f32>& column : full)
+    {
+        column.resize(count);
+    }
+    std::vector<f32> times(count);
+    std::vector<i32> traversalTimes(count, 1000);
+    for (u32 i = 0; i < count; i++)
+    {
+        const CVector* vectors[4] = {&inputs[i].startCoors, &inputs[i].endCoors, &inputs[i].startDir,
+            &inputs[i].endDir};
+        for (u32 v = 0; v < 4; v++)
+        {
+            full[v * 3 + 0][i] = vectors[v]->x;
+            full[v * 3 + 1][i] = vectors[v]->y;
+            full[v * 3 + 2][i] = vectors[v]->z;
+        }
+        times[i] = inputs[i].Time;
+    }
+
+    std::vector<f32> results[6];
+    for (std::vector<f32>& column : results)
+    {
+        column.resize(count);
+    }
+    const CCurveBatchResult result = {results[0].data(), results[1].data(), results[2].data(), results[3].data(),
+        results[4].data(), results[5].data()};
+    const CCurveBatch batch = {full[0].data(), full[1].data(), full[2].data(), full[3].data(), full[4].data(),
+        full[5].data(), full[6].data(), full[7].data(), full[8].data(), full[9].data(), full[10].data(),
+        full[11].data(), times.data(), traversalTimes.data()};
+
+    const f64 fullMs = BestOf(20, [&]
+    {
+        CCurves::CalcCurvePoints(batch, count, result);
+        g_Sink = results[0][count / 2];
+    });
+    const f64 compactMs = BestOf(20, [&]
+    {
+        CCompactCurve::CalcCurvePoints(origin, compact.data(), times.data(), traversalTimes.data(), count, result);
+        g_Sink = results[0][count / 2];
+    });
+
+    std::printf("\n%-36s %12s\n", "CalcCurvePoints sweep", "ms");
+    std::printf("%-36s %12.3f\n", "full SoA arrays", fullMs);
+    std::printf("%-36s %12.3f\n", "CCompactCurve", compactMs);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Worst-case deviation of the CCurveFast precision policy from CCurveExact, per function
+//
+// ulp is the distance in representable floats, which blows up for results near zero. approx is the deviation in
+// units of the TestCurves tolerance (FLOAT_EQUAL), anything up to 1 would pass the tests.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "curve_inputs.hpp"
+#include "curve_math.hpp"
+
+namespace
+{
+using Exact = CCurveMathT<CCurveExact>;
+using Fast = CCurveMathT<CCurveFast>;
+
+// maps the floats onto integers in the same order, so neighbouring floats are 1 apart
+i64 OrderedBits(f32 value)
+{
+    i32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits < 0 ? -static_cast<i64>(bits & 0x7FFFFFFF) : static_cast<i64>(bits);
+}
+
+struct CDeviation
+{
+    const char* Name;
+    i64 MaxUlp = 0;
+    f64 MaxApprox = 0.0;
+    u32 Failed = 0;
+    u32 Samples = 0;
+
+    void Add(f32 exact, f32 fast)
+    {
+        const i64 ulp = std::abs(OrderedBits(exact) - OrderedBits(fast));
+        const f64 diff = std::fabs(static_cast<f64>(exact) - fast);
+        const f64 tolerance = FLT_EPSILON * 100.0 * (1.0 + std::max(std::fabs(exact), std::fabs(fast)));
+
+        MaxUlp = std::max(MaxUlp, ulp);
+        MaxApprox = std::max(MaxApprox, diff / tolerance);
+        Failed += diff >= tolerance;
+        Samples++;
+    }
+
+    void Print() const
+    {
+        std::printf("%-36s %12lld %12.4f %8u / %u\n", Name, MaxUlp, MaxApprox, Failed, Samples);
+    }
+};
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const u32 count = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 1u << 18;
+
+    const std::vector<CCurveInput> inputs = MakePlainCurveInputs(count, 1337);
+
+    CDeviation distForLine{"DistForLineToCrossOtherLine"};
+    CDeviation speedVariation{"CalcSpeedVariationInBend"};
+    CDeviation speedScaleFactor{"CalcSpeedScaleFactor"};
+    CDeviation correctedDist{"CalcCorrectedDist"};
+    CDeviation correctedInterpol{"CalcCorrectedDist (interpolation)"};
+    CDeviation curveCoor{"CalcCurvePoint (coordinates)"};
+    CDeviation curveSpeed{"CalcCurvePoint (speed)"};
+
+    for (const CCurveInput& in : inputs)
+    {
+        const CVector& s = in.startCoors;
+        const CVector& e = in.endCoors;
+        const CVector& sd = in.startDir;
+        const CVector& ed = in.endDir;
+
+        distForLine.Add(Exact::DistForLineToCrossOtherLine(s.x, s.y, sd.x, sd.y, e.x, e.y, ed.x, ed.y),
+            Fast::DistForLineToCrossOtherLine(s.x, s.y, sd.x, sd.y, e.x, e.y, ed.x, ed.y));
+        speedVariation.Add(Exact::CalcSpeedVariationInBend(s, e, sd.x, sd.y, ed.x, ed.y),
+            Fast::CalcSpeedVariationInBend(s, e, sd.x, sd.y, ed.x, ed.y));
+        speedScaleFactor.Add(Exact::CalcSpeedScaleFactor(s, e, sd.x, sd.y, ed.x, ed.y),
+            Fast::CalcSpeedScaleFactor(s, e, sd.x, sd.y, ed.x, ed.y));
+
+        // same ranges as CalcCurvePoint's fallback passes
+        const f32 total = (s - e).Magnitude2D() * 1.5f;
+        f32 exactInterpol, fastInterpol;
+        correctedDist.Add(Exact::CalcCorrectedDist(total * in.Time, total, 0.2f, &exactInterpol),
+            Fast::CalcCorrectedDist(total * in.Time, total, 0.2f, &fastInterpol));
+        correctedInterpol.Add(exactInterpol, fastInterpol);
+
+        CVector exactCoor, exactSpeed, fastCoor, fastSpeed;
+        Exact::CalcCurvePoint(s, e, sd, ed, in.Time, 1000, exactCoor, exactSpeed);
+        Fast::CalcCurvePoint(s, e, sd, ed, in.Time, 1000, fastCoor, fastSpeed);
+        curveCoor.Add(exactCoor.x, fastCoor.x);
+        curveCoor.Add(exactCoor.y, fastCoor.y);
+        curveCoor.Add(exactCoor.z, fastCoor.z);
+        curveSpeed.Add(exactSpeed.x, fastSpeed.x);
+        curveSpeed.Add(exactSpeed.y, fastSpeed.y);
+    }
+
+    std::printf("CCurveFast vs CCurveExact, %u random curves\n\n", count);
+    std::printf("%-36s %12s %12s %19s\n", "", "max ulp", "max approx", "outside approx");
+    for (const CDeviation* deviation :
+        {&distForLine, &speedVariation, &speedScaleFactor, &correctedDist, &correctedInterpol, &curveCoor, &curveSpeed})
+    {
+        deviation->Print();
+    }
+
+    return 0;
+}
@@ -4,9 +4,9 @@
 #include <numeric>
 
 struct Approx {
-  Approx(double value);
+  constexpr Approx(double value);
 
-  Approx operator()(double value) const;
+  constexpr Approx operator()(double value) const;
 
 #ifdef DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
   template <typename T>
@@ -18,7 +18,7 @@ struct Approx {
   }
 #endif // DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
 
-  Approx &epsilon(double newEpsilon);
+  constexpr Approx &epsilon(double newEpsilon);
 
 #ifdef DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
   template <typename T>
@@ -30,7 +30,7 @@ struct Approx {
   }
 #endif //  DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
 
-  Approx &scale(double newScale);
+  constexpr Approx &scale(double newScale);
 
 #ifdef DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
   template <typename T>
@@ -43,18 +43,18 @@ struct Approx {
 #endif // DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
 
   // clang-format off
-     friend bool operator==(double lhs, const Approx & rhs);
-     friend bool operator==(const Approx & lhs, double rhs);
-     friend bool operator!=(double lhs, const Approx & rhs);
-     friend bool operator!=(const Approx & lhs, double rhs);
-     friend bool operator<=(double lhs, const Approx & rhs);
-     friend bool operator<=(const Approx & lhs, double rhs);
-     friend bool operator>=(double lhs, const Approx & rhs);
-     friend bool operator>=(const Approx & lhs, double rhs);
-     friend bool operator< (double lhs, const Approx & rhs);
-     friend bool operator< (const Approx & lhs, double rhs);
-     friend bool operator> (double lhs, const Approx & rhs);
-     friend bool operator> (const Approx & lhs, double rhs);
+     friend constexpr bool operator==(double lhs, const Approx & rhs);
+     friend constexpr bool operator==(const Approx & lhs, double rhs);
+     friend constexpr bool operator!=(double lhs, const Approx & rhs);
+     friend constexpr bool operator!=(const Approx & lhs, double rhs);
+     friend constexpr bool operator<=(double lhs, const Approx & rhs);
+     friend constexpr bool operator<=(const Approx & lhs, double rhs);
+     friend constexpr bool operator>=(double lhs, const Approx & rhs);
+     friend constexpr bool operator>=(const Approx & lhs, double rhs);
+     friend constexpr bool operator< (double lhs, const Approx & rhs);
+     friend constexpr bool operator< (const Approx & lhs, double rhs);
+     friend constexpr bool operator> (double lhs, const Approx & rhs);
+     friend constexpr bool operator> (const Approx & lhs, double rhs);
 
 #ifdef DOCTEST_CONFIG_INCLUDE_TYPE_TRAITS
 #define DOCTEST_APPROX_PREFIX \
@@ -82,58 +82,61 @@ struct Approx {
   double m_value;
 };
 
-Approx::Approx(double value)
+constexpr Approx::Approx(double value)
     : m_epsilon(static_cast<double>(FLT_EPSILON) *
                 100),
       m_scale(1.0), m_value(value) {}
 
-Approx Approx::operator()(double value) const {
+constexpr Approx Approx::operator()(double value) const {
   Approx approx(value);
   approx.epsilon(m_epsilon);
   approx.scale(m_scale);
   return approx;
 }
 
-Approx &Approx::epsilon(double newEpsilon) {
+constexpr Approx &Approx::epsilon(double newEpsilon) {
   m_epsilon = newEpsilon;
   return *this;
 }
-Approx &Approx::scale(double newScale) {
+constexpr Approx &Approx::scale(double newScale) {
   m_scale = newScale;
   return *this;
 }
 
-bool operator==(double lhs, const Approx &rhs) {
+constexpr bool operator==(double lhs, const Approx &rhs) {
+  // local fabs, std::fabs isn't constexpr on every compiler we build with and
+  // the curve math tests also run as static_asserts
+  constexpr auto fabs = [](double value) { return value < 0.0 ? -value : value; };
   // Thanks to Richard Harris for his help refining this formula
   return fabs(lhs - rhs.m_value) <
          rhs.m_epsilon *
              (rhs.m_scale +
               std::max<double>(fabs(lhs), fabs(rhs.m_value)));
 }
-bool operator==(const Approx &lhs, double rhs) { return operator==(rhs, lhs); }
-bool operator!=(double lhs, const Approx &rhs) { return !operator==(lhs, rhs); }
-bool operator!=(const Approx &lhs, double rhs) { return !operator==(rhs, lhs); }
-bool operator<=(double lhs, const Approx &rhs) {
+constexpr bool operator==(const Approx &lhs, double rhs) { return operator==(rhs, lhs); }
+constexpr bool operator!=(double lhs, const Approx &rhs) { return !operator==(lhs, rhs); }
+constexpr bool operator!=(const Approx &lhs, double rhs) { return !operator==(rhs, lhs); }
+constexpr bool operator<=(double lhs, const Approx &rhs) {
   return lhs < rhs.m_value || lhs == rhs;
 }
-bool operator<=(const Approx &lhs, double rhs) {
+constexpr bool operator<=(const Approx &lhs, double rhs) {
   return lhs.m_value < rhs || lhs == rhs;
 }
-bool operator>=(double lhs, const Approx &rhs) {
+constexpr bool operator>=(double lhs, const Approx &rhs) {
   return lhs > rhs.m_value || lhs == rhs;
 }
-bool operator>=(const Approx &lhs, double rhs) {
+constexpr bool operator>=(const Approx &lhs, double rhs) {
   return lhs.m_value > rhs || lhs == rhs;
 }
-bool operator<(double lhs, const Approx &rhs) {
+constexpr bool operator<(double lhs, const Approx &rhs) {
   return lhs < rhs.m_value && lhs != rhs;
 }
-bool operator<(const Approx &lhs, double rhs) {
+constexpr bool operator<(const Approx &lhs, double rhs) {
   return lhs.m_value < rhs && lhs != rhs;
 }
-bool operator>(double lhs, const Approx &rhs) {
+constexpr bool operator>(double lhs, const Approx &rhs) {
   return lhs > rhs.m_value && lhs != rhs;
 }
-bool operator>(const Approx &lhs, double rhs) {
+constexpr bool operator>(const Approx &lhs, double rhs) {
   return lhs.m_value > rhs && lhs != rhs;
 }
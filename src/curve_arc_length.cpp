@@ -0,0 +1,54 @@
+#include <cfloat>
+
+#include "curve_arc_length.hpp"
+
+CCurveArcLength::CCurveArcLength(const CCurveSegment& segment)
+{
+    // Cumulative chord length at evenly spaced Time steps, fine enough to follow the bend
+    f32 cumulative[NUM_BUILD_STEPS + 1];
+
+    // The second straight starts at EndCoors rather than where the bend ends, nothing moves over the jump between
+    // them, so the step across it only counts the parts on either side
+    const f32 secondStraightDist = segment.bCrossing ? segment.StraightDist1 + segment.BendDist : FLT_MAX;
+    const CVector bendEnd = segment.EndCoors - segment.EndDir * segment.StraightDist2;
+
+    CVector prevCoor, resultCoor, resultSpeed;
+    CCurves::CalcCurvePoint(segment, 0.0f, 1000, prevCoor, resultSpeed);
+    cumulative[0] = 0.0f;
+    bool bPrevOnSecondStraight = false;
+
+    for (u32 i = 1; i <= NUM_BUILD_STEPS; i++)
+    {
+        const f32 Time = static_cast<f32>(i) / static_cast<f32>(NUM_BUILD_STEPS);
+        CCurves::CalcCurvePoint(segment, Time, 1000, resultCoor, resultSpeed);
+
+        const bool bOnSecondStraight = segment.TotalDist_Time * Time > secondStraightDist;
+        const f32 stepLength = bOnSecondStraight && !bPrevOnSecondStraight
+                                   ? (bendEnd - prevCoor).Magnitude() + (resultCoor - segment.EndCoors).Magnitude()
+                                   : (resultCoor - prevCoor).Magnitude();
+        cumulative[i] = cumulative[i - 1] + stepLength;
+        prevCoor = resultCoor;
+        bPrevOnSecondStraight = bOnSecondStraight;
+    }
+
+    Length = cumulative[NUM_BUILD_STEPS];
+
+    // Invert it, the Time at every NUM_INTERVALS-th of the length
+    u32 step = 0;
+    for (u32 i = 0; i <= NUM_INTERVALS; i++)
+    {
+        const f32 target = Length * static_cast<f32>(i) / static_cast<f32>(NUM_INTERVALS);
+
+        while (step < NUM_BUILD_STEPS - 1 && cumulative[step + 1] < target)
+        {
+            step++;
+        }
+
+        const f32 stepLength = cumulative[step + 1] - cumulative[step];
+        const f32 frac = stepLength > 0.0f ? VCLAMP(0.0f, 1.0f, (target - cumulative[step]) / stepLength) : 0.0f;
+        Times[i] = (static_cast<f32>(step) + frac) / static_cast<f32>(NUM_BUILD_STEPS);
+    }
+
+    Times[0] = 0.0f;
+    Times[NUM_INTERVALS] = 1.0f;
+}
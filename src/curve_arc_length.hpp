@@ -0,0 +1,36 @@
+#pragma once
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+/// Arc-length parametrization of a curve, for moving along it at a constant world-space speed.
+///
+/// `CCurves::CalcCurvePoint` doesn't move at a uniform speed through the bend (nor through the fallback blend), so
+/// equal `Time` steps don't cover equal distances. This table stores the `Time` at which the curve has covered
+/// evenly spaced fractions of its length, and maps a distance back to `Time` with one lookup and a lerp. The jump to
+/// the start of the second straight isn't part of the length.
+struct CCurveArcLength
+{
+    static constexpr u32 NUM_INTERVALS = 32;
+    static constexpr u32 NUM_BUILD_STEPS = NUM_INTERVALS * 8;  // CalcCurvePoint calls made by the constructor
+
+    f32 Length;                    // world-space length of the curve
+    f32 Times[NUM_INTERVALS + 1];  // Time at Length * i / NUM_INTERVALS
+
+    CCurveArcLength() {}
+    explicit CCurveArcLength(const CCurveSegment& segment);
+
+    /// Returns the `Time` at which the curve has covered `Dist` world units, `Dist` is clamped to [0, Length].
+    f32 FindTimeAtDist(f32 Dist) const
+    {
+        if (Length <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        const f32 pos = VCLAMP(0.0f, 1.0f, Dist / Length) * static_cast<f32>(NUM_INTERVALS);
+        const u32 i = pos >= static_cast<f32>(NUM_INTERVALS) ? NUM_INTERVALS - 1 : static_cast<u32>(pos);
+        const f32 frac = pos - static_cast<f32>(i);
+        return Times[i] + (Times[i + 1] - Times[i]) * frac;
+    }
+};
@@ -0,0 +1,274 @@
+#include <algorithm>
+
+#include "curve_bvh.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// traversal stack, the median split keeps the tree depth at log2(curves / MAX_CURVES_PER_LEAF)
+constexpr u32 MAX_DEPTH = 64;
+
+// covers the rounding of CalcCurvePoint against the exact hull
+constexpr f32 BOUNDS_MARGIN = 0.01f;
+
+void GrowBounds(CCurveBounds& bounds, const CVector& point)
+{
+    bounds.Min = CVector(
+        std::min(bounds.Min.x, point.x), std::min(bounds.Min.y, point.y), std::min(bounds.Min.z, point.z));
+    bounds.Max = CVector(
+        std::max(bounds.Max.x, point.x), std::max(bounds.Max.y, point.y), std::max(bounds.Max.z, point.z));
+}
+
+CCurveBounds UnionBounds(const CCurveBounds& a, const CCurveBounds& b)
+{
+    CCurveBounds bounds = a;
+    GrowBounds(bounds, b.Min);
+    GrowBounds(bounds, b.Max);
+    return bounds;
+}
+
+f32 DistToBoundsSqr(const CCurveBounds& bounds, const CVector& point)
+{
+    const f32 dx = std::max(std::max(bounds.Min.x - point.x, point.x - bounds.Max.x), 0.0f);
+    const f32 dy = std::max(std::max(bounds.Min.y - point.y, point.y - bounds.Max.y), 0.0f);
+    const f32 dz = std::max(std::max(bounds.Min.z - point.z, point.z - bounds.Max.z), 0.0f);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+f32 DistToCurveSqr(const CCurveSegment& segment, const CVector& point)
+{
+    CVector closest;
+    CCurves::FindClosestTime(segment, point, closest);
+    const CVector d = closest - point;
+    return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+}  // namespace
+
+CCurveBVH::CCurveBVH(const CCurveSegment* pSegments, u32 Count)
+{
+    Build(pSegments, Count);
+}
+
+void CCurveBVH::Build(const CCurveSegment* pSegments, u32 Count)
+{
+    m_Segments.assign(pSegments, pSegments + Count);
+    m_Indices.resize(Count);
+    m_Nodes.clear();
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    std::vector<CCurveBounds> bounds(Count);
+    for (u32 i = 0; i < Count; i++)
+    {
+        m_Indices[i] = i;
+        bounds[i] = CalcBounds(m_Segments[i]);
+    }
+
+    m_Nodes.reserve(2 * (Count / MAX_CURVES_PER_LEAF + 1));
+    BuildNode(0, Count, bounds);
+}
+
+u32 CCurveBVH::BuildNode(u32 Begin, u32 End, const std::vector<CCurveBounds>& bounds)
+{
+    const u32 nodeIndex = static_cast<u32>(m_Nodes.size());
+    m_Nodes.push_back({});
+
+    CCurveBounds nodeBounds = bounds[m_Indices[Begin]];
+    CCurveBounds centers = {CVector(3.4e38f, 3.4e38f, 3.4e38f), CVector(-3.4e38f, -3.4e38f, -3.4e38f)};
+    for (u32 i = Begin; i < End; i++)
+    {
+        const CCurveBounds& curveBounds = bounds[m_Indices[i]];
+        nodeBounds = UnionBounds(nodeBounds, curveBounds);
+        GrowBounds(centers, (curveBounds.Min + curveBounds.Max) * 0.5f);
+    }
+
+    if (End - Begin <= MAX_CURVES_PER_LEAF)
+    {
+        m_Nodes[nodeIndex] = {nodeBounds, Begin, End - Begin};
+        return nodeIndex;
+    }
+
+    // median split along the axis the box centers spread the most on
+    const CVector extent = centers.Max - centers.Min;
+    const u32 axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const auto center = [&](u32 Index)
+    {
+        const CCurveBounds& curveBounds = bounds[Index];
+        return axis == 0 ? curveBounds.Min.x + curveBounds.Max.x
+                         : (axis == 1 ? curveBounds.Min.y + curveBounds.Max.y : curveBounds.Min.z + curveBounds.Max.z);
+    };
+
+    const u32 mid = Begin + (End - Begin) / 2;
+    std::nth_element(m_Indices.begin() + Begin, m_Indices.begin() + mid, m_Indices.begin() + End,
+        [&](u32 a, u32 b) { return center(a) < center(b); });
+
+    BuildNode(Begin, mid, bounds);
+    const u32 right = BuildNode(mid, End, bounds);
+
+    m_Nodes[nodeIndex] = {nodeBounds, right, 0};
+    return nodeIndex;
+}
+
+void CCurveBVH::Refit()
+{
+    // children always come after their parent
+    for (u32 i = static_cast<u32>(m_Nodes.size()); i-- > 0;)
+    {
+        CNode& node = m_Nodes[i];
+        if (node.Count != 0)
+        {
+            node.Bounds = CalcBounds(m_Segments[m_Indices[node.First]]);
+            for (u32 k = 1; k < node.Count; k++)
+            {
+                node.Bounds = UnionBounds(node.Bounds, CalcBounds(m_Segments[m_Indices[node.First + k]]));
+            }
+        }
+        else
+        {
+            node.Bounds = UnionBounds(m_Nodes[i + 1].Bounds, m_Nodes[node.First].Bounds);
+        }
+    }
+}
+
+i32 CCurveBVH::FindNearest(const CVector& point, f32 MaxDist, f32* pDist) const
+{
+    i32 nearest = -1;
+    f32 bestSqr = MaxDist * MaxDist;
+
+    if (m_Nodes.empty())
+    {
+        return nearest;
+    }
+
+    struct CEntry
+    {
+        u32 Node;
+        f32 DistSqr;
+    };
+    CEntry stack[MAX_DEPTH];
+    u32 stackSize = 0;
+    stack[stackSize++] = {0, DistToBoundsSqr(m_Nodes[0].Bounds, point)};
+
+    while (stackSize > 0)
+    {
+        const CEntry entry = stack[--stackSize];
+        if (entry.DistSqr > bestSqr)
+        {
+            continue;
+        }
+
+        const CNode& node = m_Nodes[entry.Node];
+        if (node.Count != 0)
+        {
+            for (u32 k = 0; k < node.Count; k++)
+            {
+                const u32 index = m_Indices[node.First + k];
+                const f32 distSqr = DistToCurveSqr(m_Segments[index], point);
+                if (distSqr <= bestSqr)
+                {
+                    bestSqr = distSqr;
+                    nearest = static_cast<i32>(index);
+                }
+            }
+            continue;
+        }
+
+        // nearer child on top, so it is searched first and tightens bestSqr for the other one
+        CEntry left = {entry.Node + 1, DistToBoundsSqr(m_Nodes[entry.Node + 1].Bounds, point)};
+        CEntry right = {node.First, DistToBoundsSqr(m_Nodes[node.First].Bounds, point)};
+        if (left.DistSqr < right.DistSqr)
+        {
+            std::swap(left, right);
+        }
+        stack[stackSize++] = left;
+        stack[stackSize++] = right;
+    }
+
+    if (pDist && nearest >= 0)
+    {
+        *pDist = CMaths::Sqrt(bestSqr);
+    }
+    return nearest;
+}
+
+u32 CCurveBVH::FindInRadius(const CVector& point, f32 Radius, u32* pIndices, u32 MaxIndices) const
+{
+    u32 numFound = 0;
+
+    if (m_Nodes.empty())
+    {
+        return numFound;
+    }
+
+    const f32 radiusSqr = Radius * Radius;
+    u32 stack[MAX_DEPTH];
+    u32 stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const u32 nodeIndex = stack[--stackSize];
+        const CNode& node = m_Nodes[nodeIndex];
+        if (DistToBoundsSqr(node.Bounds, point) > radiusSqr)
+        {
+            continue;
+        }
+
+        if (node.Count != 0)
+        {
+            for (u32 k = 0; k < node.Count; k++)
+            {
+                const u32 index = m_Indices[node.First + k];
+                if (DistToCurveSqr(m_Segments[index], point) <= radiusSqr)
+                {
+                    if (numFound < MaxIndices)
+                    {
+                        pIndices[numFound] = index;
+                    }
+                    numFound++;
+                }
+            }
+            continue;
+        }
+
+        stack[stackSize++] = nodeIndex + 1;
+        stack[stackSize++] = node.First;
+    }
+
+    return numFound;
+}
+
+CCurveBounds CCurveBVH::CalcBounds(const CCurveSegment& segment)
+{
+    CCurveBounds bounds = {segment.StartCoors, segment.StartCoors};
+    GrowBounds(bounds, segment.EndCoors);
+
+    if (segment.bCrossing)
+    {
+        // where the start ray reaches the end ray and back, the bend stays inside this hull; the second straight
+        // starts at EndCoors and runs on past it
+        GrowBounds(bounds, segment.StartCoors + segment.StartDir * segment.DistToPoint1);
+        GrowBounds(bounds, segment.EndCoors - segment.EndDir * segment.DistToPoint2);
+        GrowBounds(bounds, segment.EndCoors + segment.EndDir * segment.StraightDist2);
+    }
+    else
+    {
+        // CalcCorrectedDist rises monotonically from 0 to StraightDist over the curve (SpeedVariation <= 1/3), and
+        // the result blends a point on each ray at that distance
+        GrowBounds(bounds, segment.StartCoors + segment.StartDir * segment.StraightDist);
+        GrowBounds(bounds, segment.EndCoors - segment.EndDir * segment.StraightDist);
+    }
+
+    const CVector margin(BOUNDS_MARGIN, BOUNDS_MARGIN, BOUNDS_MARGIN);
+    bounds.Min = bounds.Min - margin;
+    bounds.Max = bounds.Max + margin;
+    return bounds;
+}
+
+f32 CCurveBVH::DistToCurve(const CCurveSegment& segment, const CVector& point)
+{
+    return CMaths::Sqrt(DistToCurveSqr(segment, point));
+}
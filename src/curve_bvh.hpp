@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include "curves.hpp"
+
+/// Axis-aligned box, as built by `CCurveBVH::CalcBounds`.
+struct CCurveBounds
+{
+    CVector Min;
+    CVector Max;
+};
+
+/// Bounding volume hierarchy over a set of curves, for finding the curve something knocked off its path should
+/// rejoin without testing every link.
+///
+/// The curves are kept as `CCurveSegment` copies and addressed by their index in the array the tree was built from.
+/// Queries only descend into boxes that can still beat the best hit so far, which is logarithmic in the curve count
+/// for the usual spread-out path networks. After moving curves with `SetCurve`, `Refit` updates the boxes without
+/// rebuilding the tree; rebuild instead if the curves moved far.
+class CCurveBVH
+{
+public:
+    static constexpr u32 MAX_CURVES_PER_LEAF = 4;
+
+    CCurveBVH() {}
+    CCurveBVH(const CCurveSegment* pSegments, u32 Count);
+
+    /// Rebuilds the tree over a new set of curves.
+    void Build(const CCurveSegment* pSegments, u32 Count);
+
+    /// Replaces a curve, the tree is out of date until the next `Refit` (or `Build`).
+    void SetCurve(u32 Index, const CCurveSegment& segment) { m_Segments[Index] = segment; }
+
+    /// Recomputes every box bottom-up for the current curves, keeping the tree topology.
+    void Refit();
+
+    /// Finds the curve closest to `point`.
+    /// \param point The position to search from.
+    /// \param MaxDist Curves further away than this are ignored.
+    /// \param pDist Receives the distance to the curve found, may be null.
+    /// \return The index of the closest curve, -1 if none is within `MaxDist`.
+    i32 FindNearest(const CVector& point, f32 MaxDist, f32* pDist = nullptr) const;
+
+    /// Finds every curve within `Radius` of `point`.
+    /// \param pIndices Receives the indices of the curves found, in no particular order.
+    /// \param MaxIndices Size of `pIndices`, curves past it are counted but not stored.
+    /// \return The number of curves within `Radius`.
+    u32 FindInRadius(const CVector& point, f32 Radius, u32* pIndices, u32 MaxIndices) const;
+
+    u32 GetNumCurves() const { return static_cast<u32>(m_Segments.size()); }
+    const CCurveSegment& GetCurve(u32 Index) const { return m_Segments[Index]; }
+
+    /// Conservative bounds of everything `CCurves::CalcCurvePoint` returns for Time in [0, 1].
+    ///
+    /// A crossing curve never leaves the polyline start - crossing - end (the bend blends points on both rays) but for
+    /// its second straight, which runs on from the end. A non-crossing one stays between the two rays over the range
+    /// `CCurves::CalcCorrectedDist` can return.
+    static CCurveBounds CalcBounds(const CCurveSegment& segment);
+
+    /// Distance from `point` to the curve, at the closest point `CCurves::FindClosestTime` finds.
+    static f32 DistToCurve(const CCurveSegment& segment, const CVector& point);
+
+private:
+    // leaf when Count != 0, its curves are m_Indices[First, First + Count); otherwise the children are the node right
+    // after this one and m_Nodes[First]
+    struct CNode
+    {
+        CCurveBounds Bounds;
+        u32 First;
+        u32 Count;
+    };
+
+    u32 BuildNode(u32 Begin, u32 End, const std::vector<CCurveBounds>& bounds);
+
+    std::vector<CCurveSegment> m_Segments;
+    std::vector<u32> m_Indices;
+    std::vector<CNode> m_Nodes;
+};
@@ -0,0 +1,229 @@
+#include <algorithm>
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// samples seeding the solves, the bend is a quadratic; the fallback blend folds into a hairpin on sharp turns, which
+// needs the finer spacing so a seed lands on each side of it
+constexpr u32 NUM_BEND_SEEDS = 5;
+constexpr u32 NUM_FALLBACK_SEEDS = 9;
+constexpr u32 NUM_ITERATIONS = 3;
+
+f32 Dot(const CVector& a, const CVector& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+f32 DistSqr(const CVector& a, const CVector& b)
+{
+    const CVector d = a - b;
+    return Dot(d, d);
+}
+
+// Distance along a straight from Base in direction Dir, closest to point and clamped to [0, Length]
+f32 ProjectOnStraight(const CVector& Base, const CVector& Dir, f32 Length, const CVector& point)
+{
+    const f32 dirSqr = Dot(Dir, Dir);
+    return dirSqr > 0.0f ? VCLAMP(0.0f, Length, Dot(point - Base, Dir) / dirSqr) : 0.0f;
+}
+
+// Position and derivative at BendInter t of the bend, the same blend as CalcCurvePoint:
+// (BendStart + StartDir * B * t) * (1 - t) + (BendEnd - EndDir * B * (1 - t)) * t = A + (C - A + K) * t - K * t^2
+struct CBend
+{
+    CVector A;  // bend start
+    CVector L;  // linear term C - A + K
+    CVector K;  // (StartDir - EndDir) * BendDistOneSegment
+
+    CVector Position(f32 t) const { return A + L * t - K * (t * t); }
+    CVector Derivative(f32 t) const { return L - K * (2.0f * t); }
+};
+
+// Position and first two derivatives over Time of the fallback blend, see CalcCurvePoint. With c the corrected
+// distance and i the interpolation value: f = Ps(c) * (1 - i) + Pe(c) * i, both points moving along their ray at c'.
+// CalcCorrectedDist is expanded here so every trig term comes from one sine and cosine of PI * Time, the polynomial
+// ones are plenty for the solve since the final point comes from CalcCurvePoint.
+void CalcFallbackPoint(const CCurveSegment& segment, f32 Time, CVector& resultCoor, CVector& resultDerivative,
+    CVector& resultSecondDerivative)
+{
+    const f32 sinHalf = CMaths::FastSin(Time * PI);
+    const f32 cosHalf = CMaths::FastCos(Time * PI);
+    const f32 sinFull = 2.0f * sinHalf * cosHalf;
+    const f32 cosFull = 1.0f - 2.0f * sinHalf * sinHalf;
+
+    const f32 BendDist = segment.BendDist;
+    const f32 SpeedVariation = segment.SpeedVariation;
+    const f32 Interpol = 0.5f - cosHalf * 0.5f;
+    const f32 CurrentDist_Time =
+        (1.0f - SpeedVariation) * BendDist * Time + (BendDist / TWO_PI) * SpeedVariation * sinFull;
+
+    const CVector startPoint = segment.StartCoors + segment.StartDir * CurrentDist_Time;
+    const CVector endPoint = segment.EndCoors + segment.EndDir * (CurrentDist_Time - segment.StraightDist);
+    resultCoor = startPoint * (1.0f - Interpol) + endPoint * Interpol;
+
+    const f32 distRate = BendDist * ((1.0f - SpeedVariation) + SpeedVariation * cosFull);
+    const f32 distAccel = -BendDist * SpeedVariation * TWO_PI * sinFull;
+    const f32 interpolRate = HALF_PI * sinHalf;
+    const f32 interpolAccel = HALF_PI * PI * cosHalf;
+
+    const CVector dir = segment.StartDir * (1.0f - Interpol) + segment.EndDir * Interpol;
+    const CVector gap = endPoint - startPoint;
+    const CVector gapRate = (segment.EndDir - segment.StartDir) * distRate;
+    resultDerivative = dir * distRate + gap * interpolRate;
+    resultSecondDerivative = dir * distAccel + gapRate * (2.0f * interpolRate) + gap * interpolAccel;
+}
+
+// Newton steps on d/dt |f(t) - point|^2 = 0 from the middle of [lo, hi]. Steps leaving the bracket (or where the
+// distance curves downwards) bisect it instead, so the solve can't wander off to another local minimum.
+template <typename PointFn>
+void RefineClosest(const CVector& point, PointFn&& Evaluate, f32 lo, f32 hi, f32& Best, f32& BestDistSqr)
+{
+    f32 t = (lo + hi) * 0.5f;
+    CVector position, derivative, secondDerivative;
+    for (u32 i = 0; i <= NUM_ITERATIONS; i++)
+    {
+        Evaluate(t, position, derivative, secondDerivative);
+
+        const CVector offset = position - point;
+        const f32 distSqr = Dot(offset, offset);
+        if (distSqr < BestDistSqr)
+        {
+            BestDistSqr = distSqr;
+            Best = t;
+        }
+
+        const f32 slope = Dot(offset, derivative);
+        if (slope < 0.0f)
+        {
+            lo = t;
+        }
+        else
+        {
+            hi = t;
+        }
+
+        const f32 curvature = Dot(derivative, derivative) + Dot(offset, secondDerivative);
+        const f32 next = curvature > 0.0f ? t - slope / curvature : lo - 1.0f;
+        t = next > lo && next < hi ? next : (lo + hi) * 0.5f;
+    }
+}
+
+// Seeds at even steps over [0, 1], then refines every seed interval the distance falls into at its start and rises
+// out of at its end, each of those holds a local minimum. The curves can fold back past themselves, so the interval
+// next to the closest seed may not be the one holding the closest point; an interval the curve turns around in can
+// hide a minimum and a maximum between two same-signed slopes, both its halves are refined.
+template <u32 NUM_SEEDS, typename PointFn>
+f32 SolveClosest(const CVector& point, PointFn&& Evaluate, f32& BestDistSqr)
+{
+    constexpr f32 seedStep = 1.0f / static_cast<f32>(NUM_SEEDS - 1);
+
+    f32 best = 0.0f;
+    BestDistSqr = 3.4e38f;
+
+    f32 seedSlope[NUM_SEEDS];
+    CVector seedDerivative[NUM_SEEDS];
+    CVector position, derivative, secondDerivative;
+    for (u32 i = 0; i < NUM_SEEDS; i++)
+    {
+        const f32 t = static_cast<f32>(i) * seedStep;
+        Evaluate(t, position, derivative, secondDerivative);
+
+        const CVector offset = position - point;
+        const f32 distSqr = Dot(offset, offset);
+        if (distSqr < BestDistSqr)
+        {
+            BestDistSqr = distSqr;
+            best = t;
+        }
+        seedSlope[i] = Dot(offset, derivative);
+        seedDerivative[i] = derivative;
+    }
+
+    for (u32 i = 0; i + 1 < NUM_SEEDS; i++)
+    {
+        const f32 lo = static_cast<f32>(i) * seedStep;
+        const f32 hi = lo + seedStep;
+        if (seedSlope[i] < 0.0f && seedSlope[i + 1] > 0.0f)
+        {
+            RefineClosest(point, Evaluate, lo, hi, best, BestDistSqr);
+        }
+        else if (Dot(seedDerivative[i], seedDerivative[i + 1]) < 0.0f)
+        {
+            RefineClosest(point, Evaluate, lo, (lo + hi) * 0.5f, best, BestDistSqr);
+            RefineClosest(point, Evaluate, (lo + hi) * 0.5f, hi, best, BestDistSqr);
+        }
+    }
+
+    return best;
+}
+}  // namespace
+
+f32 CCurves::FindClosestTime(const CCurveSegment& segment, const CVector& point, CVector& resultCoor)
+{
+    f32 Time;
+
+    if (!segment.bCrossing)
+    {
+        f32 distSqr;
+        Time = SolveClosest<NUM_FALLBACK_SEEDS>(point,
+            [&](f32 t, CVector& position, CVector& derivative, CVector& secondDerivative)
+            { CalcFallbackPoint(segment, t, position, derivative, secondDerivative); },
+            distSqr);
+    }
+    else if (segment.TotalDist_Time <= 0.0f)
+    {
+        // start and end on the crossing, the whole curve is one point
+        Time = 0.0f;
+    }
+    else
+    {
+        const f32 TotalDist_Time = segment.TotalDist_Time;
+
+        // first straight, distance along it from the start
+        const f32 dist1 = ProjectOnStraight(segment.StartCoors, segment.StartDir, segment.StraightDist1, point);
+        const f32 distSqr1 = DistSqr(segment.StartCoors + segment.StartDir * dist1, point);
+
+        // second straight, distance along it from the end coors where it starts
+        const f32 dist2 = ProjectOnStraight(segment.EndCoors, segment.EndDir, segment.StraightDist2, point);
+        const f32 distSqr2 = DistSqr(segment.EndCoors + segment.EndDir * dist2, point);
+
+        // bend, a quadratic in BendInter
+        CBend bend;
+        bend.A = segment.StartCoors + segment.StartDir * segment.StraightDist1;
+        bend.K = (segment.StartDir - segment.EndDir) * segment.BendDistOneSegment;
+        bend.L = (segment.EndCoors - segment.EndDir * segment.StraightDist2) - bend.A + bend.K;
+
+        f32 bendDistSqr;
+        const f32 bendInter = SolveClosest<NUM_BEND_SEEDS>(point,
+            [&](f32 t, CVector& position, CVector& derivative, CVector& secondDerivative)
+            {
+                position = bend.Position(t);
+                derivative = bend.Derivative(t);
+                secondDerivative = bend.K * -2.0f;
+            },
+            bendDistSqr);
+
+        if (distSqr1 <= distSqr2 && distSqr1 <= bendDistSqr)
+        {
+            Time = dist1 / TotalDist_Time;
+        }
+        else if (distSqr2 <= bendDistSqr)
+        {
+            // the time of the very end of the bend still evaluates the bend
+            Time = std::max((segment.StraightDist1 + segment.BendDist + dist2) / TotalDist_Time,
+                segment.GetSecondStraightTime());
+        }
+        else
+        {
+            Time = (segment.StraightDist1 + segment.BendDist * bendInter) / TotalDist_Time;
+        }
+    }
+
+    Time = VCLAMP(0.0f, 1.0f, Time);
+
+    CVector resultSpeed;
+    CalcCurvePoint(segment, Time, 1000, resultCoor, resultSpeed);
+    return Time;
+}
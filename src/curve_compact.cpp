@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "curve_compact.hpp"
+#include "maths.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CURVE_COMPACT_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+constexpr f32 SNORM_SCALE = 32767.0f;
+
+// curves decoded at a time by CCompactCurve::CalcCurvePoints, 12 KiB of stack
+constexpr u32 DECODE_BLOCK = 256;
+
+i16 EncodeCoor(f32 Coor, f32 Origin)
+{
+    const f32 scaled = std::round((Coor - Origin) * CCompactCurve::COORS_SCALE);
+    return static_cast<i16>(std::clamp(scaled, -SNORM_SCALE, SNORM_SCALE));
+}
+
+f32 DecodeCoor(i16 Coor, f32 Origin)
+{
+    return Origin + static_cast<f32>(Coor) * (1.0f / CCompactCurve::COORS_SCALE);
+}
+
+// +1 for zero, the octahedron folds onto the positive side there
+f32 SignNotZero(f32 Value)
+{
+    return Value < 0.0f ? -1.0f : 1.0f;
+}
+
+// The fold of the lower half written without a branch, horizontal directions sit right on the fold and would go
+// either way at random: moving u and v by -z towards zero is (1 - |v|) * sign(u), (1 - |u|) * sign(v) for z < 0
+CVector DecodeDir(const i16* pDir)
+{
+    f32 u = static_cast<f32>(pDir[0]) * (1.0f / SNORM_SCALE);
+    f32 v = static_cast<f32>(pDir[1]) * (1.0f / SNORM_SCALE);
+    const f32 z = 1.0f - std::fabs(u) - std::fabs(v);
+    const f32 fold = std::max(-z, 0.0f);
+    u -= std::copysign(fold, u);
+    v -= std::copysign(fold, v);
+
+    const f32 invLength = 1.0f / CMaths::Sqrt(u * u + v * v + z * z);
+    return CVector(u * invLength, v * invLength, z * invLength);
+}
+
+// DecodeDir on both directions of a curve at once, one square root and division for the two. Same results.
+void DecodeDirs(const i16* pStartDir, const i16* pEndDir, CVector& startDir, CVector& endDir)
+{
+#ifdef CURVE_COMPACT_SSE
+    const __m128 scale = _mm_set1_ps(1.0f / SNORM_SCALE);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    // the start direction in lane 0, the end one in lane 1
+    __m128 u = _mm_mul_ps(_mm_setr_ps(pStartDir[0], pEndDir[0], 0.0f, 0.0f), scale);
+    __m128 v = _mm_mul_ps(_mm_setr_ps(pStartDir[1], pEndDir[1], 0.0f, 0.0f), scale);
+    const __m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(signMask, u)), _mm_andnot_ps(signMask, v));
+    const __m128 fold = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+    u = _mm_sub_ps(u, _mm_or_ps(fold, _mm_and_ps(signMask, u)));
+    v = _mm_sub_ps(v, _mm_or_ps(fold, _mm_and_ps(signMask, v)));
+
+    const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z));
+    const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+
+    alignas(16) f32 dirs[3][4];
+    _mm_store_ps(dirs[0], _mm_mul_ps(u, invLength));
+    _mm_store_ps(dirs[1], _mm_mul_ps(v, invLength));
+    _mm_store_ps(dirs[2], _mm_mul_ps(z, invLength));
+    startDir = CVector(dirs[0][0], dirs[1][0], dirs[2][0]);
+    endDir = CVector(dirs[0][1], dirs[1][1], dirs[2][1]);
+#else
+    startDir = DecodeDir(pStartDir);
+    endDir = DecodeDir(pEndDir);
+#endif
+}
+
+// Rounding both components to the nearest step isn't always the closest direction after the fold, so this tries
+// the four neighbouring steps and keeps the best one
+void EncodeDir(const CVector& dir, i16* pDir)
+{
+    const f32 l1 = std::fabs(dir.x) + std::fabs(dir.y) + std::fabs(dir.z);
+    const CVector unit = l1 > 0.0f ? dir * (1.0f / l1) : CVector(0.0f, 0.0f, 1.0f);
+
+    f32 u = unit.x;
+    f32 v = unit.y;
+    if (unit.z < 0.0f)
+    {
+        const f32 foldedU = (1.0f - std::fabs(v)) * SignNotZero(u);
+        v = (1.0f - std::fabs(u)) * SignNotZero(v);
+        u = foldedU;
+    }
+
+    const f32 baseU = std::floor(std::clamp(u, -1.0f, 1.0f) * SNORM_SCALE);
+    const f32 baseV = std::floor(std::clamp(v, -1.0f, 1.0f) * SNORM_SCALE);
+
+    f64 bestSinSq = DBL_MAX;
+    for (u32 i = 0; i < 4; i++)
+    {
+        const f32 candidateU = std::min(baseU + static_cast<f32>(i & 1), SNORM_SCALE);
+        const f32 candidateV = std::min(baseV + static_cast<f32>(i >> 1), SNORM_SCALE);
+        const i16 candidate[2] = {static_cast<i16>(candidateU), static_cast<i16>(candidateV)};
+        const CVector decoded = DecodeDir(candidate);
+
+        // The squared sine of the angle to the input, up to its length which is the same for every candidate. Not
+        // the dot product, the cosine of these angles is 1 to within the rounding of the decoded direction's length.
+        const f64 crossX = static_cast<f64>(decoded.y) * unit.z - static_cast<f64>(decoded.z) * unit.y;
+        const f64 crossY = static_cast<f64>(decoded.z) * unit.x - static_cast<f64>(decoded.x) * unit.z;
+        const f64 crossZ = static_cast<f64>(decoded.x) * unit.y - static_cast<f64>(decoded.y) * unit.x;
+        const f64 lengthSq = static_cast<f64>(decoded.x) * decoded.x + static_cast<f64>(decoded.y) * decoded.y +
+                             static_cast<f64>(decoded.z) * decoded.z;
+        const f64 sinSq = (crossX * crossX + crossY * crossY + crossZ * crossZ) / lengthSq;
+        if (sinSq < bestSinSq)
+        {
+            bestSinSq = sinSq;
+            pDir[0] = candidate[0];
+            pDir[1] = candidate[1];
+        }
+    }
+}
+}  // namespace
+
+CCompactCurve::CCompactCurve(const CVector& origin, const CVector& startCoors, const CVector& endCoors,
+    const CVector& startDir, const CVector& endDir)
+{
+    StartCoors[0] = EncodeCoor(startCoors.x, origin.x);
+    StartCoors[1] = EncodeCoor(startCoors.y, origin.y);
+    StartCoors[2] = EncodeCoor(startCoors.z, origin.z);
+    EndCoors[0] = EncodeCoor(endCoors.x, origin.x);
+    EndCoors[1] = EncodeCoor(endCoors.y, origin.y);
+    EndCoors[2] = EncodeCoor(endCoors.z, origin.z);
+    EncodeDir(startDir, StartDir);
+    EncodeDir(endDir, EndDir);
+}
+
+bool CCompactCurve::IsInRange(const CVector& origin, const CVector& coors)
+{
+    return std::fabs(coors.x - origin.x) <= MAX_OFFSET && std::fabs(coors.y - origin.y) <= MAX_OFFSET &&
+           std::fabs(coors.z - origin.z) <= MAX_OFFSET;
+}
+
+void CCompactCurve::Decode(
+    const CVector& origin, CVector& startCoors, CVector& endCoors, CVector& startDir, CVector& endDir) const
+{
+    startCoors = CVector(
+        DecodeCoor(StartCoors[0], origin.x), DecodeCoor(StartCoors[1], origin.y), DecodeCoor(StartCoors[2], origin.z));
+    endCoors = CVector(
+        DecodeCoor(EndCoors[0], origin.x), DecodeCoor(EndCoors[1], origin.y), DecodeCoor(EndCoors[2], origin.z));
+    DecodeDirs(StartDir, EndDir, startDir, endDir);
+}
+
+CCurveSegment CCompactCurve::ToSegment(const CVector& origin) const
+{
+    CVector startCoors, endCoors, startDir, endDir;
+    Decode(origin, startCoors, endCoors, startDir, endDir);
+    return CCurveSegment(startCoors, endCoors, startDir, endDir);
+}
+
+void CCompactCurve::CalcCurvePoint(
+    const CVector& origin, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed) const
+{
+    CVector startCoors, endCoors, startDir, endDir;
+    Decode(origin, startCoors, endCoors, startDir, endDir);
+    CCurves::CalcCurvePoint(
+        startCoors, endCoors, startDir, endDir, Time, TraverselTimeInMillis, resultCoor, resultSpeed);
+}
+
+f32 CCompactCurve::CalcSpeedScaleFactor(const CVector& origin) const
+{
+    CVector startCoors, endCoors, startDir, endDir;
+    Decode(origin, startCoors, endCoors, startDir, endDir);
+    return CCurves::CalcSpeedScaleFactor(startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+}
+
+void CCompactCurve::CalcCurvePoints(const CVector& origin, const CCompactCurve* pCurves, const f32* pTime,
+    const i32* pTraverselTimeInMillis, u32 Count, const CCurveBatchResult& result)
+{
+    // StartX .. EndDirZ, one row per CCurveBatch input
+    f32 decoded[12][DECODE_BLOCK];
+
+    for (u32 begin = 0; begin < Count; begin += DECODE_BLOCK)
+    {
+        const u32 blockCount = std::min(Count - begin, DECODE_BLOCK);
+        for (u32 i = 0; i < blockCount; i++)
+        {
+            CVector startCoors, endCoors, startDir, endDir;
+            pCurves[begin + i].Decode(origin, startCoors, endCoors, startDir, endDir);
+
+            const CVector* vectors[4] = {&startCoors, &endCoors, &startDir, &endDir};
+            for (u32 v = 0; v < 4; v++)
+            {
+                decoded[v * 3 + 0][i] = vectors[v]->x;
+                decoded[v * 3 + 1][i] = vectors[v]->y;
+                decoded[v * 3 + 2][i] = vectors[v]->z;
+            }
+        }
+
+        const CCurveBatch batch = {decoded[0], decoded[1], decoded[2], decoded[3], decoded[4], decoded[5], decoded[6],
+            decoded[7], decoded[8], decoded[9], decoded[10], decoded[11], pTime + begin,
+            pTraverselTimeInMillis + begin};
+        const CCurveBatchResult blockResult = {result.CoorX + begin, result.CoorY + begin, result.CoorZ + begin,
+            result.SpeedX + begin, result.SpeedY + begin, result.SpeedZ + begin};
+        CCurves::CalcCurvePoints(batch, blockCount, blockResult);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "curves.hpp"
+
+/// A curve of the path network packed into 20 bytes, for sweeping every link each frame.
+///
+/// The ends are 16-bit fixed point in 1/8 units relative to the origin of the sector the curve is stored in, the
+/// same step as the game's path nodes, so curves between path nodes round-trip exactly (from an origin on the 1/8
+/// grid). That covers `MAX_OFFSET` around the origin in every axis, the whole map from a single origin at 0.
+/// Directions are stored as unit vectors, octahedral-mapped onto two 16-bit signed components.
+///
+/// Against the 48 bytes of the four `CVector`s (88 of a `CCurveSegment` with its invariants), decoding costs about
+/// 10 ns a curve with both directions normalized together, so it pays off where the sweep waits on memory rather
+/// than on the curve math. Bounds of the quantization, the `curves-compact-report` tool measures their effect:
+///
+/// - coordinates within 1/16 unit per axis of the encoded ones (0 for the 1/8 grid), clamped beyond `MAX_OFFSET`
+/// - directions within 5e-5 rad of the encoded ones, whatever their length was
+///
+/// On random links 99% of the `CalcCurvePoint` results move by less than 0.4 units and the speed scale factor by less
+/// than 1.5%. Rays close to parallel cross far away, and the direction error moves that crossing a long way or flips
+/// the curve between the crossing and the fallback path. Directions that weren't unit length change the curve as
+/// well, `CCurves::CalcCurvePoint` moves along them at their length.
+struct CCompactCurve
+{
+    static constexpr f32 COORS_SCALE = 8.0f;
+    static constexpr f32 MAX_OFFSET = 32767.0f / COORS_SCALE;
+
+    i16 StartCoors[3];  // relative to the sector origin, in 1 / COORS_SCALE units
+    i16 EndCoors[3];
+    i16 StartDir[2];  // octahedral, in 1 / 32767
+    i16 EndDir[2];
+
+    CCompactCurve() {}
+
+    /// \param origin The sector origin the coordinates are stored relative to, pass the same one to decode.
+    CCompactCurve(const CVector& origin, const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+        const CVector& endDir);
+
+    /// Whether `coors` is within `MAX_OFFSET` of `origin` in every axis, coordinates further out are clamped.
+    static bool IsInRange(const CVector& origin, const CVector& coors);
+
+    void Decode(const CVector& origin, CVector& startCoors, CVector& endCoors, CVector& startDir,
+        CVector& endDir) const;
+
+    CCurveSegment ToSegment(const CVector& origin) const;
+
+    /// `CCurves::CalcCurvePoint` on the decoded curve.
+    void CalcCurvePoint(
+        const CVector& origin, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed) const;
+
+    /// `CCurves::CalcSpeedScaleFactor` on the decoded curve.
+    f32 CalcSpeedScaleFactor(const CVector& origin) const;
+
+    /// `CCurves::CalcCurvePoints` over an array of curves of one sector, decoded a block at a time on the stack.
+    /// \param pTime Time of every curve.
+    /// \param pTraverselTimeInMillis Traversal time of every curve.
+    /// \param result Receives the point and speed of every curve.
+    static void CalcCurvePoints(const CVector& origin, const CCompactCurve* pCurves, const f32* pTime,
+        const i32* pTraverselTimeInMillis, u32 Count, const CCurveBatchResult& result);
+};
+
+static_assert(sizeof(CCompactCurve) == 20);
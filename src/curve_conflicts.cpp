@@ -0,0 +1,262 @@
+#include <algorithm>
+
+#include "curve_conflicts.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// most grid cells per agent, for agents far apart
+constexpr f32 GRID_CELLS_PER_AGENT = 4.0f;
+
+// boxes covering more cells are tested from their own cell range instead of being binned
+constexpr u32 MAX_CELLS_PER_BOX = 16;
+
+f32 Dot(const CVector& a, const CVector& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+bool Overlaps(const CCurveBounds& a, const CCurveBounds& b)
+{
+    return a.Min.x <= b.Max.x && b.Min.x <= a.Max.x && a.Min.y <= b.Max.y && b.Min.y <= a.Max.y &&
+           a.Min.z <= b.Max.z && b.Min.z <= a.Max.z;
+}
+}  // namespace
+
+void CCurveConflicts::Sweep(const CCurveAgent& agent, f32 WindowMillis, CSweptAgent& swept)
+{
+    const f32 timeStep = WindowMillis / (static_cast<f32>(agent.TraverselTimeInMillis) * static_cast<f32>(NUM_STEPS));
+
+    CVector speed;
+    CCurves::CalcCurvePoint(*agent.pSegment, agent.Time, agent.TraverselTimeInMillis, swept.Positions[0], speed);
+    CCurveBounds bounds = {swept.Positions[0], swept.Positions[0]};
+    for (u32 i = 1; i <= NUM_STEPS; i++)
+    {
+        CVector& position = swept.Positions[i];
+        CCurves::CalcCurvePoint(*agent.pSegment, agent.Time + timeStep * static_cast<f32>(i),
+            agent.TraverselTimeInMillis, position, speed);
+
+        bounds.Min = CVector(std::min(bounds.Min.x, position.x), std::min(bounds.Min.y, position.y),
+            std::min(bounds.Min.z, position.z));
+        bounds.Max = CVector(std::max(bounds.Max.x, position.x), std::max(bounds.Max.y, position.y),
+            std::max(bounds.Max.z, position.z));
+    }
+
+    const CVector radius(agent.Radius, agent.Radius, agent.Radius);
+    swept.Bounds = {bounds.Min - radius, bounds.Max + radius};
+    swept.Radius = agent.Radius;
+}
+
+// The offset between the agents is linear over a step, d0 + e * s for s in [0, 1]: its closest point is the
+// projection of -d0 on e, and the first contact the smaller root of |d0 + e * s|^2 = r^2
+bool CCurveConflicts::Narrow(const CSweptAgent& a, const CSweptAgent& b, f32 WindowMillis, CCurveConflict& result)
+{
+    const f32 stepMillis = WindowMillis / static_cast<f32>(NUM_STEPS);
+    const f32 contactDist = a.Radius + b.Radius;
+    const f32 contactDistSqr = contactDist * contactDist;
+
+    f32 closestDistSqr = 3.4e38f;
+    f32 closestStep = 0.0f;
+    f32 contactStep = -1.0f;
+    for (u32 i = 0; i < NUM_STEPS; i++)
+    {
+        const CVector d0 = a.Positions[i] - b.Positions[i];
+        const CVector e = (a.Positions[i + 1] - b.Positions[i + 1]) - d0;
+        const f32 ee = Dot(e, e);
+        const f32 de = Dot(d0, e);
+        const f32 dd = Dot(d0, d0);
+
+        const f32 s = ee > 0.0f ? VCLAMP(0.0f, 1.0f, -de / ee) : 0.0f;
+        const CVector closest = d0 + e * s;
+        const f32 distSqr = Dot(closest, closest);
+        if (distSqr < closestDistSqr)
+        {
+            closestDistSqr = distSqr;
+            closestStep = static_cast<f32>(i) + s;
+        }
+
+        if (contactStep < 0.0f && distSqr <= contactDistSqr)
+        {
+            // starting outside means the distance shrinks through r before s, so ee > 0
+            f32 root = 0.0f;
+            if (dd > contactDistSqr)
+            {
+                const f32 discriminant = std::max(de * de - ee * (dd - contactDistSqr), 0.0f);
+                root = (-de - CMaths::Sqrt(discriminant)) / ee;
+            }
+            contactStep = static_cast<f32>(i) + VCLAMP(0.0f, s, root);
+        }
+    }
+
+    result.ContactTime = contactStep * stepMillis;
+    result.ClosestTime = closestStep * stepMillis;
+    result.ClosestDist = CMaths::Sqrt(closestDistSqr);
+    return contactStep >= 0.0f;
+}
+
+bool CCurveConflicts::CalcClosestApproach(
+    const CCurveAgent& a, const CCurveAgent& b, f32 WindowMillis, CCurveConflict& result)
+{
+    CSweptAgent sweptA, sweptB;
+    Sweep(a, WindowMillis, sweptA);
+    Sweep(b, WindowMillis, sweptB);
+    return Narrow(sweptA, sweptB, WindowMillis, result);
+}
+
+void CCurveConflicts::Update(const CCurveAgent* pAgents, u32 Count, f32 WindowMillis)
+{
+    m_Agents.resize(Count);
+    m_Cells.resize(Count);
+    m_Conflicts.clear();
+    m_nNumCandidates = 0;
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    CCurveBounds area = {CVector(3.4e38f, 3.4e38f, 0.0f), CVector(-3.4e38f, -3.4e38f, 0.0f)};
+    m_Extents.resize(Count);
+    for (u32 i = 0; i < Count; i++)
+    {
+        Sweep(pAgents[i], WindowMillis, m_Agents[i]);
+
+        const CCurveBounds& bounds = m_Agents[i].Bounds;
+        area.Min = CVector(std::min(area.Min.x, bounds.Min.x), std::min(area.Min.y, bounds.Min.y), 0.0f);
+        area.Max = CVector(std::max(area.Max.x, bounds.Max.x), std::max(area.Max.y, bounds.Max.y), 0.0f);
+        m_Extents[i] = std::max(bounds.Max.x - bounds.Min.x, bounds.Max.y - bounds.Min.y);
+    }
+
+    // Cells about the size of the median box, so most boxes touch a few cells, but no more cells than
+    // GRID_CELLS_PER_AGENT per agent when they are small and far apart. Not the mean, a fallback curve between
+    // nearly parallel rays sweeps a box kilometres wide and would make every cell crowded.
+    std::nth_element(m_Extents.begin(), m_Extents.begin() + Count / 2, m_Extents.end());
+    const f32 width = area.Max.x - area.Min.x;
+    const f32 height = area.Max.y - area.Min.y;
+    const f32 minCellSize = CMaths::Sqrt(width * height / (static_cast<f32>(Count) * GRID_CELLS_PER_AGENT));
+    const f32 cellSize = std::max({m_Extents[Count / 2], minCellSize, 1e-3f});
+    const f32 invCellSize = 1.0f / cellSize;
+    const u32 numColumns = static_cast<u32>(width * invCellSize) + 1;
+    const u32 numRows = static_cast<u32>(height * invCellSize) + 1;
+
+    const auto CellOf = [&](f32 Coor, f32 Origin, u32 NumCells)
+    {
+        return std::min(static_cast<u32>((Coor - Origin) * invCellSize), NumCells - 1);
+    };
+
+    const auto TestPair = [&](u32 a, u32 b)
+    {
+        if (!Overlaps(m_Agents[a].Bounds, m_Agents[b].Bounds))
+        {
+            return;
+        }
+        m_nNumCandidates++;
+
+        CCurveConflict conflict;
+        conflict.AgentA = std::min(a, b);
+        conflict.AgentB = std::max(a, b);
+        if (Narrow(m_Agents[conflict.AgentA], m_Agents[conflict.AgentB], WindowMillis, conflict))
+        {
+            m_Conflicts.push_back(conflict);
+        }
+    };
+
+    // agents of cell c are m_CellAgents[m_CellStarts[c] .. m_CellStarts[c + 1]), counted then filled; boxes covering
+    // more than MAX_CELLS_PER_BOX cells are left out, they would crowd every cell they cover
+    m_CellStarts.assign(numColumns * numRows + 1, 0);
+    m_LargeAgents.clear();
+    for (u32 i = 0; i < Count; i++)
+    {
+        const CCurveBounds& bounds = m_Agents[i].Bounds;
+        CCellRange& cells = m_Cells[i];
+        cells = {CellOf(bounds.Min.x, area.Min.x, numColumns), CellOf(bounds.Min.y, area.Min.y, numRows),
+            CellOf(bounds.Max.x, area.Min.x, numColumns), CellOf(bounds.Max.y, area.Min.y, numRows)};
+
+        if ((cells.MaxX - cells.MinX + 1) * (cells.MaxY - cells.MinY + 1) > MAX_CELLS_PER_BOX)
+        {
+            m_LargeAgents.push_back(i);
+            continue;
+        }
+
+        for (u32 y = cells.MinY; y <= cells.MaxY; y++)
+        {
+            for (u32 x = cells.MinX; x <= cells.MaxX; x++)
+            {
+                m_CellStarts[y * numColumns + x + 1]++;
+            }
+        }
+    }
+    for (u32 c = 0; c < numColumns * numRows; c++)
+    {
+        m_CellStarts[c + 1] += m_CellStarts[c];
+    }
+
+    m_CellAgents.resize(m_CellStarts.back());
+    m_CellFill.assign(m_CellStarts.begin(), m_CellStarts.end() - 1);
+    for (u32 i = 0; i < Count; i++)
+    {
+        const CCellRange& cells = m_Cells[i];
+        if ((cells.MaxX - cells.MinX + 1) * (cells.MaxY - cells.MinY + 1) > MAX_CELLS_PER_BOX)
+        {
+            continue;
+        }
+
+        for (u32 y = cells.MinY; y <= cells.MaxY; y++)
+        {
+            for (u32 x = cells.MinX; x <= cells.MaxX; x++)
+            {
+                m_CellAgents[m_CellFill[y * numColumns + x]++] = i;
+            }
+        }
+    }
+
+    // A pair sharing several cells is tested only in the first of them, the cell at the larger of both minimums
+    const auto IsFirstCell = [&](u32 a, u32 b, u32 x, u32 y)
+    {
+        return std::max(m_Cells[a].MinX, m_Cells[b].MinX) == x && std::max(m_Cells[a].MinY, m_Cells[b].MinY) == y;
+    };
+
+    for (u32 y = 0; y < numRows; y++)
+    {
+        for (u32 x = 0; x < numColumns; x++)
+        {
+            const u32 cell = y * numColumns + x;
+            for (u32 i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+            {
+                for (u32 j = i + 1; j < m_CellStarts[cell + 1]; j++)
+                {
+                    if (IsFirstCell(m_CellAgents[i], m_CellAgents[j], x, y))
+                    {
+                        TestPair(m_CellAgents[i], m_CellAgents[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    // the large boxes against the agents in the cells they cover, and against each other
+    for (u32 l = 0; l < m_LargeAgents.size(); l++)
+    {
+        const u32 large = m_LargeAgents[l];
+        const CCellRange& cells = m_Cells[large];
+        for (u32 y = cells.MinY; y <= cells.MaxY; y++)
+        {
+            for (u32 x = cells.MinX; x <= cells.MaxX; x++)
+            {
+                const u32 cell = y * numColumns + x;
+                for (u32 i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+                {
+                    if (IsFirstCell(large, m_CellAgents[i], x, y))
+                    {
+                        TestPair(large, m_CellAgents[i]);
+                    }
+                }
+            }
+        }
+
+        for (u32 other = l + 1; other < m_LargeAgents.size(); other++)
+        {
+            TestPair(large, m_LargeAgents[other]);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+
+#include "curve_bvh.hpp"
+#include "curves.hpp"
+
+/// An agent moving along a curve, as handed to `CCurveConflicts::Update`.
+struct CCurveAgent
+{
+    const CCurveSegment* pSegment;  // the curve it's on, must outlive the update
+    f32 Time;                       // where on the curve it is now
+    i32 TraverselTimeInMillis;      // of the whole curve
+    f32 Radius;                     // agents closer than the sum of their radii conflict
+};
+
+/// Two agents coming within their radii of each other, times in milliseconds from now.
+struct CCurveConflict
+{
+    u32 AgentA;  // the lower index
+    u32 AgentB;
+    f32 ContactTime;  // when they first come within their radii
+    f32 ClosestTime;  // when they are closest, the earliest of several equally close times
+    f32 ClosestDist;
+};
+
+/// Finds the agents that will come too close to each other within a time window, for stopping at junctions without
+/// checking every pair of `CCurves::CalcCurvePoint` results.
+///
+/// Every agent's path over the window is sampled at `NUM_STEPS` even time steps, and the samples and the box around
+/// them (grown by the radius) stand for its swept volume. The boxes are binned into a uniform grid of cells about
+/// the median box size, and the pairs whose boxes overlap in a cell go on to the narrowphase: the distance between
+/// the two agents minimized step by step, their motion taken as linear between the samples. The few boxes covering
+/// many cells, fast agents or wide fallback curves, aren't binned but tested against the cells they cover. The work
+/// is linear in the agent count for agents spread over a road network, plus the pairs that are actually close.
+///
+/// Agents reaching the end of their curve within the window wait there, `CalcCurvePoint` clamps their `Time`. The
+/// buffers are kept across updates, nothing is allocated once they have grown to the agent and pair counts.
+class CCurveConflicts
+{
+public:
+    static constexpr u32 NUM_STEPS = 8;
+
+    /// Finds the conflicts of `Count` agents over the next `WindowMillis` milliseconds, replacing the last ones.
+    void Update(const CCurveAgent* pAgents, u32 Count, f32 WindowMillis);
+
+    /// The conflicts found by the last `Update`, in no particular order.
+    u32 GetNumConflicts() const { return static_cast<u32>(m_Conflicts.size()); }
+    const CCurveConflict& GetConflict(u32 Index) const { return m_Conflicts[Index]; }
+
+    /// Pairs the broadphase passed to the narrowphase in the last `Update`.
+    u32 GetNumCandidates() const { return m_nNumCandidates; }
+
+    /// Closest approach of two agents over the window, the narrowphase of `Update` on its own.
+    /// \param result Receives the times and distance, with the agent indices left as they were.
+    /// \return Whether they come within the sum of their radii.
+    static bool CalcClosestApproach(const CCurveAgent& a, const CCurveAgent& b, f32 WindowMillis,
+        CCurveConflict& result);
+
+private:
+    // an agent's path over the window
+    struct CSweptAgent
+    {
+        CVector Positions[NUM_STEPS + 1];
+        CCurveBounds Bounds;  // of the positions, grown by the radius
+        f32 Radius;
+    };
+
+    // grid cells an agent's box covers, inclusive
+    struct CCellRange
+    {
+        u32 MinX, MinY;
+        u32 MaxX, MaxY;
+    };
+
+    static void Sweep(const CCurveAgent& agent, f32 WindowMillis, CSweptAgent& swept);
+    static bool Narrow(const CSweptAgent& a, const CSweptAgent& b, f32 WindowMillis, CCurveConflict& result);
+
+    std::vector<CSweptAgent> m_Agents;
+    std::vector<CCellRange> m_Cells;
+    std::vector<f32> m_Extents;     // box sizes, for the median
+    std::vector<u32> m_CellStarts;  // of every cell in m_CellAgents, and the end of the last one
+    std::vector<u32> m_CellFill;
+    std::vector<u32> m_CellAgents;
+    std::vector<u32> m_LargeAgents;  // boxes covering too many cells to bin
+    std::vector<CCurveConflict> m_Conflicts;
+    u32 m_nNumCandidates = 0;
+};
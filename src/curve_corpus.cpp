@@ -0,0 +1,409 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "curve_corpus.hpp"
+#include "curve_inputs.hpp"
+#include "curve_thread_pool.hpp"
+#include "maths.hpp"
+#include "approx.hpp"
+
+namespace
+{
+constexpr char MAGIC[8] = {'C', 'R', 'V', 'C', 'O', 'R', 'P', 'S'};
+
+// records generated and written at once, and handed to a pool thread at once
+constexpr u64 RECORDS_PER_BLOCK = 1 << 16;
+constexpr u64 RECORDS_PER_CHUNK = 2048;
+
+constexpr u32 RECORD_SIZES[CCurveCorpus::NUM_FUNCTIONS] = {
+    sizeof(CCurveCorpus::CDistForLineRecord),
+    sizeof(CCurveCorpus::CBendRecord),
+    sizeof(CCurveCorpus::CBendRecord),
+    sizeof(CCurveCorpus::CCorrectedDistRecord),
+    sizeof(CCurveCorpus::CCurvePointRecord),
+};
+
+// the file format, see CCurveMappedFile
+static_assert(sizeof(CVector) == 12);
+static_assert(sizeof(CCurveCorpus::CDistForLineRecord) == 36);
+static_assert(sizeof(CCurveCorpus::CBendRecord) == 44);
+static_assert(sizeof(CCurveCorpus::CCorrectedDistRecord) == 20);
+static_assert(sizeof(CCurveCorpus::CCurvePointRecord) == 80);
+static_assert(sizeof(CCurveCorpus::CHeader) == 24 + 24 * CCurveCorpus::NUM_FUNCTIONS);
+
+constexpr const char* FUNCTION_NAMES[CCurveCorpus::NUM_FUNCTIONS] = {
+    "DistForLineToCrossOtherLine",
+    "CalcSpeedVariationInBend",
+    "CalcSpeedScaleFactor",
+    "CalcCorrectedDist",
+    "CalcCurvePoint",
+};
+
+// What a record is made from, the Total and SpeedVariation for CalcCorrectedDist
+struct CRecordInput
+{
+    CCurveInput Curve;
+    f32 Total;
+    f32 SpeedVariation;
+};
+
+// The curves of MakeCurveInput, every record a function of the seed and its index. One in sixteen gets a case only
+// the corpus has: both ends on one spot, directions that aren't unit length or a Total next to 0.
+CRecordInput MakeRecordInput(u64 Seed, u64 Index)
+{
+    CCurveRandom random(Seed, Index);
+
+    CRecordInput in;
+    in.Curve = MakeCurveInput(random);
+    in.Total = random.Next(0.0f, 200.0f);
+    in.SpeedVariation = random.Next(0.0f, 1.0f / 3.0f);
+
+    switch (random.NextInt(48))
+    {
+    case 0:
+        in.Curve.endCoors = in.Curve.startCoors;
+        in.Total = 0.0f;
+        break;
+    case 1:
+        in.Curve.startDir = in.Curve.startDir * random.Next(0.25f, 4.0f);
+        in.Curve.endDir = in.Curve.endDir * random.Next(0.25f, 4.0f);
+        break;
+    case 2: in.Total = random.Next(0.0f, 0.00002f); break;
+    default: break;
+    }
+    return in;
+}
+
+void MakeRecords(CCurveCorpus::eFunction Function, u64 Seed, u64 Begin, u64 End, void* pRecords)
+{
+    for (u64 i = Begin; i < End; i++)
+    {
+        const CRecordInput input = MakeRecordInput(Seed, i);
+        const CCurveInput& in = input.Curve;
+
+        switch (Function)
+        {
+        case CCurveCorpus::DIST_FOR_LINE_TO_CROSS_OTHER_LINE:
+        {
+            CCurveCorpus::CDistForLineRecord& record =
+                static_cast<CCurveCorpus::CDistForLineRecord*>(pRecords)[i - Begin];
+            record = {in.startCoors.x, in.startCoors.y, in.startDir.x, in.startDir.y, in.endCoors.x, in.endCoors.y,
+                in.endDir.x, in.endDir.y, 0.0f};
+            record.Result = CCurves::DistForLineToCrossOtherLine(record.LineBaseX, record.LineBaseY,
+                record.LineDirX, record.LineDirY, record.OtherLineBaseX, record.OtherLineBaseY, record.OtherLineDirX,
+                record.OtherLineDirY);
+            break;
+        }
+        case CCurveCorpus::CALC_SPEED_VARIATION_IN_BEND:
+        case CCurveCorpus::CALC_SPEED_SCALE_FACTOR:
+        {
+            CCurveCorpus::CBendRecord& record = static_cast<CCurveCorpus::CBendRecord*>(pRecords)[i - Begin];
+            record = {in.startCoors, in.endCoors, in.startDir.x, in.startDir.y, in.endDir.x, in.endDir.y, 0.0f};
+            record.Result = Function == CCurveCorpus::CALC_SPEED_VARIATION_IN_BEND
+                                ? CCurves::CalcSpeedVariationInBend(record.StartCoors, record.EndCoors,
+                                      record.StartDirX, record.StartDirY, record.EndDirX, record.EndDirY)
+                                : CCurves::CalcSpeedScaleFactor(record.StartCoors, record.EndCoors, record.StartDirX,
+                                      record.StartDirY, record.EndDirX, record.EndDirY);
+            break;
+        }
+        case CCurveCorpus::CALC_CORRECTED_DIST:
+        {
+            CCurveCorpus::CCorrectedDistRecord& record =
+                static_cast<CCurveCorpus::CCorrectedDistRecord*>(pRecords)[i - Begin];
+            record = {input.Total * in.Time, input.Total, input.SpeedVariation, 0.0f, 0.0f};
+            record.Result =
+                CCurves::CalcCorrectedDist(record.Current, record.Total, record.SpeedVariation, &record.InterPol);
+            break;
+        }
+        case CCurveCorpus::CALC_CURVE_POINT:
+        {
+            CCurveCorpus::CCurvePointRecord& record =
+                static_cast<CCurveCorpus::CCurvePointRecord*>(pRecords)[i - Begin];
+            record = {in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000 + static_cast<i32>(i % 4000),
+                CVector(0.0f, 0.0f, 0.0f), CVector(0.0f, 0.0f, 0.0f)};
+            CCurves::CalcCurvePoint(record.StartCoors, record.EndCoors, record.StartDir, record.EndDir, record.Time,
+                record.TraverselTimeInMillis, record.ResultCoor, record.ResultSpeed);
+            break;
+        }
+        default: break;
+        }
+    }
+}
+
+struct CMakeRecordsJob
+{
+    CCurveCorpus::eFunction Function;
+    u64 Seed;
+    u64 Begin;
+    u64 End;
+    char* pRecords;
+};
+
+void MakeRecordsChunk(void* pContext, u32 Chunk)
+{
+    const CMakeRecordsJob& job = *static_cast<const CMakeRecordsJob*>(pContext);
+    const u64 begin = job.Begin + Chunk * RECORDS_PER_CHUNK;
+    const u64 end = std::min(begin + RECORDS_PER_CHUNK, job.End);
+    MakeRecords(job.Function, job.Seed, begin, end, job.pRecords + (begin - job.Begin) * RECORD_SIZES[job.Function]);
+}
+
+bool Matches(f32 Actual, f32 Expected)
+{
+    if (std::memcmp(&Actual, &Expected, sizeof(f32)) == 0 || (std::isnan(Actual) && std::isnan(Expected)))
+    {
+        return true;
+    }
+    return Actual == Approx(Expected);
+}
+
+bool Matches(const CVector& Actual, const CVector& Expected)
+{
+    return Matches(Actual.x, Expected.x) && Matches(Actual.y, Expected.y) && Matches(Actual.z, Expected.z);
+}
+
+// Runs a record through CCurves, false if any output is off
+bool CheckRecord(CCurveCorpus::eFunction Function, const void* pRecord)
+{
+    switch (Function)
+    {
+    case CCurveCorpus::DIST_FOR_LINE_TO_CROSS_OTHER_LINE:
+    {
+        const auto& r = *static_cast<const CCurveCorpus::CDistForLineRecord*>(pRecord);
+        return Matches(CCurves::DistForLineToCrossOtherLine(r.LineBaseX, r.LineBaseY, r.LineDirX, r.LineDirY,
+                           r.OtherLineBaseX, r.OtherLineBaseY, r.OtherLineDirX, r.OtherLineDirY),
+            r.Result);
+    }
+    case CCurveCorpus::CALC_SPEED_VARIATION_IN_BEND:
+    {
+        const auto& r = *static_cast<const CCurveCorpus::CBendRecord*>(pRecord);
+        return Matches(CCurves::CalcSpeedVariationInBend(
+                           r.StartCoors, r.EndCoors, r.StartDirX, r.StartDirY, r.EndDirX, r.EndDirY),
+            r.Result);
+    }
+    case CCurveCorpus::CALC_SPEED_SCALE_FACTOR:
+    {
+        const auto& r = *static_cast<const CCurveCorpus::CBendRecord*>(pRecord);
+        return Matches(
+            CCurves::CalcSpeedScaleFactor(r.StartCoors, r.EndCoors, r.StartDirX, r.StartDirY, r.EndDirX, r.EndDirY),
+            r.Result);
+    }
+    case CCurveCorpus::CALC_CORRECTED_DIST:
+    {
+        const auto& r = *static_cast<const CCurveCorpus::CCorrectedDistRecord*>(pRecord);
+        f32 InterPol;
+        const f32 result = CCurves::CalcCorrectedDist(r.Current, r.Total, r.SpeedVariation, &InterPol);
+        return Matches(result, r.Result) && Matches(InterPol, r.InterPol);
+    }
+    case CCurveCorpus::CALC_CURVE_POINT:
+    {
+        const auto& r = *static_cast<const CCurveCorpus::CCurvePointRecord*>(pRecord);
+        CVector resultCoor, resultSpeed;
+        CCurves::CalcCurvePoint(r.StartCoors, r.EndCoors, r.StartDir, r.EndDir, r.Time, r.TraverselTimeInMillis,
+            resultCoor, resultSpeed);
+        return Matches(resultCoor, r.ResultCoor) && Matches(resultSpeed, r.ResultSpeed);
+    }
+    default: return false;
+    }
+}
+
+void PrintVector(FILE* pFile, const char* pName, const CVector& v)
+{
+    std::fprintf(pFile, "  %-22s (%.9g, %.9g, %.9g)\n", pName, v.x, v.y, v.z);
+}
+
+void PrintValue(FILE* pFile, const char* pName, f32 Value)
+{
+    std::fprintf(pFile, "  %-22s %.9g\n", pName, Value);
+}
+}  // namespace
+
+CCurveCorpus::~CCurveCorpus()
+{
+    Close();
+}
+
+bool CCurveCorpus::Write(const char* pPath, u64 NumRecords, u64 Seed, CCurveThreadPool* pPool)
+{
+    CHeader header = {};
+    std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+    header.Version = VERSION;
+    header.NumSections = NUM_FUNCTIONS;
+    header.Seed = Seed;
+
+    u64 offset = CCurveMappedFile::AlignUp(sizeof(CHeader));
+    for (u32 f = 0; f < NUM_FUNCTIONS; f++)
+    {
+        header.Sections[f] = {f, RECORD_SIZES[f], NumRecords, offset};
+        offset = CCurveMappedFile::AlignUp(offset + NumRecords * RECORD_SIZES[f]);
+    }
+
+    FILE* pFile = std::fopen(pPath, "wb");
+    if (!pFile)
+    {
+        return false;
+    }
+
+    u64 written = sizeof(header);
+    bool bOk = std::fwrite(&header, sizeof(header), 1, pFile) == 1;
+
+    std::vector<char> block(RECORDS_PER_BLOCK * sizeof(CCurvePointRecord));
+    for (u32 f = 0; f < NUM_FUNCTIONS && bOk; f++)
+    {
+        const CSection& section = header.Sections[f];
+        bOk = CCurveMappedFile::WritePadding(pFile, written, section.Offset);
+
+        for (u64 begin = 0; begin < NumRecords && bOk; begin += RECORDS_PER_BLOCK)
+        {
+            CMakeRecordsJob job = {static_cast<eFunction>(f), Seed, begin,
+                std::min(begin + RECORDS_PER_BLOCK, NumRecords), block.data()};
+            const u32 numChunks = static_cast<u32>((job.End - job.Begin + RECORDS_PER_CHUNK - 1) / RECORDS_PER_CHUNK);
+            if (pPool)
+            {
+                pPool->Run(numChunks, MakeRecordsChunk, &job);
+            }
+            else
+            {
+                for (u32 chunk = 0; chunk < numChunks; chunk++)
+                {
+                    MakeRecordsChunk(&job, chunk);
+                }
+            }
+
+            const u64 size = (job.End - job.Begin) * section.RecordSize;
+            bOk = std::fwrite(block.data(), 1, size, pFile) == size;
+            written += size;
+        }
+    }
+
+    // the last section is padded too, every section ends where the next one could start
+    if (bOk)
+    {
+        bOk = CCurveMappedFile::WritePadding(pFile, written, offset);
+    }
+
+    return std::fclose(pFile) == 0 && bOk;
+}
+
+bool CCurveCorpus::Open(const char* pPath)
+{
+    if (!m_File.Open(pPath, CCurveMappedFile::ACCESS_SEQUENTIAL))
+    {
+        return false;
+    }
+    const u64 size = m_File.GetSize();
+
+    // everything the accessors rely on, a truncated file would fault in the middle of a run instead
+    const CHeader& header = GetHeader();
+    bool bValid = size >= sizeof(CHeader) && std::memcmp(header.Magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                  header.Version == VERSION && header.NumSections == NUM_FUNCTIONS;
+    for (u32 f = 0; f < NUM_FUNCTIONS && bValid; f++)
+    {
+        const CSection& section = header.Sections[f];
+        bValid = section.Function == f && section.RecordSize == RECORD_SIZES[f] && section.Offset <= size &&
+                 section.Offset % CCurveMappedFile::SECTION_ALIGNMENT == 0 &&
+                 section.NumRecords <= (size - section.Offset) / section.RecordSize;
+    }
+
+    if (!bValid)
+    {
+        Close();
+    }
+    return bValid;
+}
+
+void CCurveCorpus::Close()
+{
+    m_File.Close();
+}
+
+CCurveCorpus::CVerifyResult CCurveCorpus::Verify(eFunction Function, u64 Begin, u64 End) const
+{
+    const char* pRecords = static_cast<const char*>(GetRecords(Function));
+    const u32 RecordSize = RECORD_SIZES[Function];
+
+    CVerifyResult result = {0, GetNumRecords(Function)};
+    for (u64 i = Begin; i < End; i++)
+    {
+        if (!CheckRecord(Function, pRecords + i * RecordSize))
+        {
+            result.FirstMismatch = result.NumMismatches++ ? result.FirstMismatch : i;
+        }
+    }
+    return result;
+}
+
+void CCurveCorpus::PrintRecord(FILE* pFile, eFunction Function, u64 Index) const
+{
+    const void* pRecord = static_cast<const char*>(GetRecords(Function)) + Index * RECORD_SIZES[Function];
+    std::fprintf(pFile, "%s record %llu:\n", GetFunctionName(Function), static_cast<unsigned long long>(Index));
+
+    switch (Function)
+    {
+    case DIST_FOR_LINE_TO_CROSS_OTHER_LINE:
+    {
+        const auto& r = *static_cast<const CDistForLineRecord*>(pRecord);
+        std::fprintf(pFile, "  line (%.9g, %.9g) dir (%.9g, %.9g), other line (%.9g, %.9g) dir (%.9g, %.9g)\n",
+            r.LineBaseX, r.LineBaseY, r.LineDirX, r.LineDirY, r.OtherLineBaseX, r.OtherLineBaseY, r.OtherLineDirX,
+            r.OtherLineDirY);
+        PrintValue(pFile, "expected", r.Result);
+        PrintValue(pFile, "actual",
+            CCurves::DistForLineToCrossOtherLine(r.LineBaseX, r.LineBaseY, r.LineDirX, r.LineDirY, r.OtherLineBaseX,
+                r.OtherLineBaseY, r.OtherLineDirX, r.OtherLineDirY));
+        break;
+    }
+    case CALC_SPEED_VARIATION_IN_BEND:
+    case CALC_SPEED_SCALE_FACTOR:
+    {
+        const auto& r = *static_cast<const CBendRecord*>(pRecord);
+        PrintVector(pFile, "startCoors", r.StartCoors);
+        PrintVector(pFile, "endCoors", r.EndCoors);
+        std::fprintf(pFile, "  startDir (%.9g, %.9g) endDir (%.9g, %.9g)\n", r.StartDirX, r.StartDirY, r.EndDirX,
+            r.EndDirY);
+        PrintValue(pFile, "expected", r.Result);
+        PrintValue(pFile, "actual",
+            Function == CALC_SPEED_VARIATION_IN_BEND
+                ? CCurves::CalcSpeedVariationInBend(
+                      r.StartCoors, r.EndCoors, r.StartDirX, r.StartDirY, r.EndDirX, r.EndDirY)
+                : CCurves::CalcSpeedScaleFactor(
+                      r.StartCoors, r.EndCoors, r.StartDirX, r.StartDirY, r.EndDirX, r.EndDirY));
+        break;
+    }
+    case CALC_CORRECTED_DIST:
+    {
+        const auto& r = *static_cast<const CCorrectedDistRecord*>(pRecord);
+        std::fprintf(pFile, "  Current %.9g Total %.9g SpeedVariation %.9g\n", r.Current, r.Total, r.SpeedVariation);
+        f32 InterPol;
+        const f32 result = CCurves::CalcCorrectedDist(r.Current, r.Total, r.SpeedVariation, &InterPol);
+        std::fprintf(pFile, "  %-22s %.9g, InterPol %.9g\n", "expected", r.Result, r.InterPol);
+        std::fprintf(pFile, "  %-22s %.9g, InterPol %.9g\n", "actual", result, InterPol);
+        break;
+    }
+    case CALC_CURVE_POINT:
+    {
+        const auto& r = *static_cast<const CCurvePointRecord*>(pRecord);
+        PrintVector(pFile, "startCoors", r.StartCoors);
+        PrintVector(pFile, "endCoors", r.EndCoors);
+        PrintVector(pFile, "startDir", r.StartDir);
+        PrintVector(pFile, "endDir", r.EndDir);
+        std::fprintf(pFile, "  Time %.9g TraverselTimeInMillis %d\n", r.Time, r.TraverselTimeInMillis);
+
+        CVector resultCoor, resultSpeed;
+        CCurves::CalcCurvePoint(r.StartCoors, r.EndCoors, r.StartDir, r.EndDir, r.Time, r.TraverselTimeInMillis,
+            resultCoor, resultSpeed);
+        PrintVector(pFile, "expected resultCoor", r.ResultCoor);
+        PrintVector(pFile, "actual resultCoor", resultCoor);
+        PrintVector(pFile, "expected resultSpeed", r.ResultSpeed);
+        PrintVector(pFile, "actual resultSpeed", resultSpeed);
+        break;
+    }
+    default: break;
+    }
+}
+
+const char* CCurveCorpus::GetFunctionName(eFunction Function)
+{
+    return FUNCTION_NAMES[Function];
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdio>
+
+#include "curve_mapped_file.hpp"
+#include "curves.hpp"
+
+class CCurveThreadPool;
+
+/// Golden data for the `CCurves` functions: their inputs and the outputs they gave, for checking an implementation
+/// against another one over far more inputs than the hand-written tests.
+///
+/// The file is a `CHeader` followed by one section of fixed-size records per function, little-endian, every section
+/// starting on a 64-byte boundary. The records are read straight out of the memory-mapped file without any parsing,
+/// so a corpus of hundreds of millions of records costs only its page cache.
+///
+/// `Write` takes the expected outputs from the `CCurves` it's linked against, which is the custom implementation in
+/// every build that writes one (curves-corpus): the corpus is a self-regression check of that implementation, it
+/// doesn't pin it to the game.
+/// `Verify` compares by the `Approx` rules of `TestCurves`, bit-identical results (NaN included) always match.
+class CCurveCorpus
+{
+public:
+    static constexpr u32 VERSION = 1;
+
+    enum eFunction : u32
+    {
+        DIST_FOR_LINE_TO_CROSS_OTHER_LINE,
+        CALC_SPEED_VARIATION_IN_BEND,
+        CALC_SPEED_SCALE_FACTOR,
+        CALC_CORRECTED_DIST,
+        CALC_CURVE_POINT,
+        NUM_FUNCTIONS
+    };
+
+    struct CDistForLineRecord
+    {
+        f32 LineBaseX, LineBaseY, LineDirX, LineDirY;
+        f32 OtherLineBaseX, OtherLineBaseY, OtherLineDirX, OtherLineDirY;
+        f32 Result;
+    };
+
+    // CalcSpeedVariationInBend and CalcSpeedScaleFactor take the same arguments
+    struct CBendRecord
+    {
+        CVector StartCoors;
+        CVector EndCoors;
+        f32 StartDirX, StartDirY, EndDirX, EndDirY;
+        f32 Result;
+    };
+
+    struct CCorrectedDistRecord
+    {
+        f32 Current, Total, SpeedVariation;
+        f32 Result;
+        f32 InterPol;
+    };
+
+    struct CCurvePointRecord
+    {
+        CVector StartCoors;
+        CVector EndCoors;
+        CVector StartDir;
+        CVector EndDir;
+        f32 Time;
+        i32 TraverselTimeInMillis;
+        CVector ResultCoor;
+        CVector ResultSpeed;
+    };
+
+    struct CSection
+    {
+        u32 Function;
+        u32 RecordSize;
+        u64 NumRecords;
+        u64 Offset;  // from the start of the file
+    };
+
+    struct CHeader
+    {
+        char Magic[8];  // "CRVCORPS"
+        u32 Version;
+        u32 NumSections;
+        u64 Seed;  // the inputs are a function of this and the record index
+        CSection Sections[NUM_FUNCTIONS];
+    };
+
+    struct CVerifyResult
+    {
+        u64 NumMismatches;
+        u64 FirstMismatch;  // index of the first mismatching record, the section's record count if none
+    };
+
+    CCurveCorpus() {}
+    ~CCurveCorpus();
+
+    CCurveCorpus(const CCurveCorpus&) = delete;
+    CCurveCorpus& operator=(const CCurveCorpus&) = delete;
+
+    /// Generates `NumRecords` records for every function and writes them to `pPath`.
+    /// \param pPool Generates the records on its threads when given, the file is still written in order.
+    /// \return false if the file couldn't be written.
+    static bool Write(const char* pPath, u64 NumRecords, u64 Seed, CCurveThreadPool* pPool = nullptr);
+
+    /// Maps a corpus written by `Write`, closing the one mapped before.
+    /// \return false if the file can't be mapped, isn't a corpus of this version or is shorter than its header says.
+    bool Open(const char* pPath);
+    void Close();
+
+    bool IsOpen() const { return m_File.IsOpen(); }
+    const CHeader& GetHeader() const { return *reinterpret_cast<const CHeader*>(m_File.GetData()); }
+    u64 GetNumRecords(eFunction Function) const { return GetHeader().Sections[Function].NumRecords; }
+
+    /// The records of a section, an array of the record struct of its function.
+    const void* GetRecords(eFunction Function) const
+    {
+        return m_File.GetData() + GetHeader().Sections[Function].Offset;
+    }
+
+    /// Runs records [Begin, End) of a function through `CCurves` and compares the outputs. Safe to call from
+    /// several threads at once on different ranges.
+    CVerifyResult Verify(eFunction Function, u64 Begin, u64 End) const;
+
+    /// Prints a record's inputs, expected outputs and what `CCurves` gives for them now.
+    void PrintRecord(FILE* pFile, eFunction Function, u64 Index) const;
+
+    static const char* GetFunctionName(eFunction Function);
+
+private:
+    CCurveMappedFile m_File;
+};
@@ -0,0 +1,119 @@
+#include "curve_cursor.hpp"
+#include "maths.hpp"
+
+CCurveCursor::CCurveCursor(const CCurveSegment& segment, i32 TraverselTimeInMillis, f32 Time)
+    : m_pSegment(&segment), m_fTimeStepScale(1.0f / static_cast<f32>(TraverselTimeInMillis))
+{
+    m_vecBendStart = segment.StartCoors + segment.StartDir * segment.StraightDist1;
+    m_vecBendEnd = segment.EndCoors - segment.EndDir * segment.StraightDist2;
+
+    // same as CalcCurvePoint's blend of the directions, split into a start value and a slope over Time
+    const f32 speed = segment.TotalDist_Time / (static_cast<f32>(TraverselTimeInMillis) * 0.001f);
+    m_vecSpeedStart = CVector(segment.StartDir.x, segment.StartDir.y, 0.0f) * speed;
+    m_vecSpeedDelta =
+        CVector(segment.EndDir.x - segment.StartDir.x, segment.EndDir.y - segment.StartDir.y, 0.0f) * speed;
+
+    SetTime(Time);
+}
+
+void CCurveCursor::SetTime(f32 Time)
+{
+    const CCurveSegment& segment = *m_pSegment;
+
+    m_fTime = VCLAMP(0.0f, 1.0f, Time);
+
+    const f32 distanceAtTime = segment.TotalDist_Time * m_fTime;
+
+    if (!segment.bCrossing)
+    {
+        m_nSection = SECTION_FALLBACK;
+    }
+    else if (distanceAtTime < segment.StraightDist1)
+    {
+        m_nSection = SECTION_FIRST_STRAIGHT;
+    }
+    else if (distanceAtTime > (segment.StraightDist1 + segment.BendDist))
+    {
+        m_nSection = SECTION_SECOND_STRAIGHT;
+    }
+    else
+    {
+        m_nSection = SECTION_BEND;
+    }
+
+    Update();
+}
+
+void CCurveCursor::Advance(f32 TimeStepInMillis)
+{
+    if (TimeStepInMillis < 0.0f)
+    {
+        // the section could move back, clamps at the start too
+        SetTime(m_fTime + TimeStepInMillis * m_fTimeStepScale);
+        return;
+    }
+
+    const CCurveSegment& segment = *m_pSegment;
+
+    m_fTime = CMaths::Min(m_fTime + TimeStepInMillis * m_fTimeStepScale, 1.0f);
+
+    // sections only ever move forward, so at most two compares decide where we are now
+    const f32 distanceAtTime = segment.TotalDist_Time * m_fTime;
+
+    if (m_nSection == SECTION_FIRST_STRAIGHT && !(distanceAtTime < segment.StraightDist1))
+    {
+        m_nSection = SECTION_BEND;
+    }
+
+    if (m_nSection == SECTION_BEND && distanceAtTime > (segment.StraightDist1 + segment.BendDist))
+    {
+        m_nSection = SECTION_SECOND_STRAIGHT;
+    }
+
+    Update();
+}
+
+void CCurveCursor::Update()
+{
+    const CCurveSegment& segment = *m_pSegment;
+    const f32 distanceAtTime = segment.TotalDist_Time * m_fTime;
+
+    switch (m_nSection)
+    {
+    case SECTION_FIRST_STRAIGHT:
+        m_vecPosition = segment.StartCoors + segment.StartDir * distanceAtTime;
+        break;
+
+    case SECTION_SECOND_STRAIGHT:
+        m_vecPosition =
+            segment.EndCoors + segment.EndDir * (distanceAtTime - (segment.StraightDist1 + segment.BendDist));
+        break;
+
+    case SECTION_BEND:
+    {
+        const f32 BendInter = (distanceAtTime - segment.StraightDist1) / segment.BendDist;
+        const f32 oneMinusBendInter = 1.0f - BendInter;
+
+        const CVector startInfluence = m_vecBendStart + segment.StartDir * (segment.BendDistOneSegment * BendInter);
+        const CVector endInfluence = m_vecBendEnd - segment.EndDir * (segment.BendDistOneSegment * oneMinusBendInter);
+
+        m_vecPosition = (startInfluence * oneMinusBendInter) + (endInfluence * BendInter);
+        break;
+    }
+
+    case SECTION_FALLBACK:
+    {
+        f32 Interpol;
+        const f32 CurrentDist_Time =
+            CCurves::CalcCorrectedDist(segment.BendDist * m_fTime, segment.BendDist, segment.SpeedVariation, &Interpol);
+
+        const CVector startPoint = segment.StartCoors + segment.StartDir * CurrentDist_Time;
+        const CVector endPoint = segment.EndCoors + segment.EndDir * (CurrentDist_Time - segment.StraightDist);
+
+        m_vecPosition = (startPoint * (1.0f - Interpol)) + (endPoint * Interpol);
+        break;
+    }
+    }
+
+    m_vecSpeed = m_vecSpeedStart + m_vecSpeedDelta * m_fTime;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "curves.hpp"
+
+/// Position of something moving along a curve, advanced in small steps every frame.
+///
+/// Remembers which section of the curve it is on and keeps the per-section constants around, so a step on a
+/// straight or through the bend costs a handful of multiply-adds instead of a whole `CCurves::CalcCurvePoint`. The
+/// results are the same as calling `CalcCurvePoint` at the cursor's current time. The fallback blend (rays that
+/// don't cross) still needs `CCurves::CalcCorrectedDist` on every step.
+class CCurveCursor
+{
+public:
+    enum eSection : u32
+    {
+        SECTION_FIRST_STRAIGHT,
+        SECTION_BEND,
+        SECTION_SECOND_STRAIGHT,
+        SECTION_FALLBACK,
+    };
+
+    /// \param segment The curve to move along, must outlive the cursor.
+    /// \param TraverselTimeInMillis The total traversal time in milliseconds for the curve.
+    /// \param Time Where to start on the curve, normalized between 0.0 and 1.0.
+    CCurveCursor(const CCurveSegment& segment, i32 TraverselTimeInMillis, f32 Time = 0.0f);
+
+    /// Moves the cursor `TimeStepInMillis` forward in time, stops at the end of the curve. A negative step goes
+    /// back like `SetTime` does and stops at the start.
+    void Advance(f32 TimeStepInMillis);
+
+    /// Jumps to an arbitrary time, going backwards included. Costs about as much as `CalcCurvePoint`.
+    void SetTime(f32 Time);
+
+    f32 GetTime() const { return m_fTime; }
+    eSection GetSection() const { return m_nSection; }
+    bool IsFinished() const { return m_fTime >= 1.0f; }
+    const CVector& GetPosition() const { return m_vecPosition; }
+    const CVector& GetSpeed() const { return m_vecSpeed; }
+
+private:
+    void Update();
+
+    const CCurveSegment* m_pSegment;
+    eSection m_nSection;
+    f32 m_fTime;
+    f32 m_fTimeStepScale;  // 1 / TraverselTimeInMillis
+
+    CVector m_vecBendStart;   // end of the first straight
+    CVector m_vecBendEnd;     // end of the bend, the second straight starts at EndCoors
+    CVector m_vecSpeedStart;  // speed at Time 0
+    CVector m_vecSpeedDelta;  // change of speed from Time 0 to 1
+
+    CVector m_vecPosition;
+    CVector m_vecSpeed;
+};
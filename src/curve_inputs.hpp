@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+/// A curve and a time on it, as the `CCurves` functions take them.
+struct CCurveInput
+{
+    CVector startCoors;
+    CVector endCoors;
+    CVector startDir;
+    CVector endDir;
+    f32 Time;
+};
+
+/// Random numbers for generated curves, splitmix64 seeded from a seed and an index: every input is a function of
+/// those two alone, so a failure reproduces from them and inputs can be made in parallel and in any order.
+class CCurveRandom
+{
+public:
+    CCurveRandom(u64 Seed, u64 Index) : m_State(Hash(Seed ^ Hash(Index))) {}
+
+    /// Uniform in [lo, hi).
+    f32 Next(f32 lo, f32 hi)
+    {
+        m_State = Hash(m_State);
+        return lo + (hi - lo) * static_cast<f32>(m_State >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /// Uniform in [0, Count).
+    u32 NextInt(u32 Count)
+    {
+        m_State = Hash(m_State);
+        return static_cast<u32>((m_State >> 32) % Count);
+    }
+
+private:
+    static u64 Hash(u64 x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    u64 m_State;
+};
+
+/// Road-like curves over the map: unit directions, some with a slope, a few parallel or opposite ones and short
+/// links, Time partly outside [0, 1]. Takes the generator so callers can draw more from it for the same index.
+inline CCurveInput MakeCurveInput(CCurveRandom& random)
+{
+    const f32 startAngle = random.Next(-PI, PI);
+    f32 endAngle = random.Next(-PI, PI);
+    switch (random.NextInt(8))
+    {
+    case 0: endAngle = startAngle; break;       // lane change or straight road
+    case 1: endAngle = startAngle + PI; break;  // u-turn
+    default: break;
+    }
+
+    const f32 offsetAngle = random.Next(-PI, PI);
+    const f32 offsetLength = random.NextInt(16) == 0 ? random.Next(0.01f, 1.0f) : random.Next(1.0f, 150.0f);
+    const f32 slope = random.NextInt(4) == 0 ? random.Next(-0.2f, 0.2f) : 0.0f;
+
+    CCurveInput in;
+    in.startCoors = CVector(random.Next(-3000.0f, 3000.0f), random.Next(-3000.0f, 3000.0f), random.Next(0.0f, 100.0f));
+    in.startDir = CVector(std::cos(startAngle), std::sin(startAngle), slope);
+    in.endDir = CVector(std::cos(endAngle), std::sin(endAngle), slope);
+    in.endCoors = in.startCoors + CVector(std::cos(offsetAngle), std::sin(offsetAngle), slope) * offsetLength;
+    in.Time = random.Next(-0.25f, 1.25f);
+    return in;
+}
+
+inline CCurveInput MakeCurveInput(u64 Seed, u64 Index)
+{
+    CCurveRandom random(Seed, Index);
+    return MakeCurveInput(random);
+}
+
+/// Plain links for the benchmarks and reports, none of the edge cases of `MakeCurveInput`: unit directions in the
+/// xy plane, ends 5 to 80 units apart and slightly sloped, Time in [0, 1].
+inline CCurveInput MakePlainCurveInput(CCurveRandom& random)
+{
+    const f32 startAngle = random.Next(-PI, PI);
+    const f32 endAngle = random.Next(-PI, PI);
+    const f32 offsetAngle = random.Next(-PI, PI);
+    const f32 offsetLength = random.Next(5.0f, 80.0f);
+
+    CCurveInput in;
+    in.startCoors =
+        CVector(random.Next(-3000.0f, 3000.0f), random.Next(-3000.0f, 3000.0f), random.Next(-50.0f, 200.0f));
+    in.startDir = CVector(std::cos(startAngle), std::sin(startAngle), 0.0f);
+    in.endDir = CVector(std::cos(endAngle), std::sin(endAngle), 0.0f);
+    in.endCoors = in.startCoors + CVector(std::cos(offsetAngle), std::sin(offsetAngle), 0.02f) * offsetLength;
+    in.Time = random.Next(0.0f, 1.0f);
+    return in;
+}
+
+/// `Count` of `MakePlainCurveInput`, for indices 0 to `Count` - 1.
+inline std::vector<CCurveInput> MakePlainCurveInputs(u32 Count, u64 Seed)
+{
+    std::vector<CCurveInput> inputs(Count);
+    for (u32 i = 0; i < Count; i++)
+    {
+        CCurveRandom random(Seed, i);
+        inputs[i] = MakePlainCurveInput(random);
+    }
+    return inputs;
+}
@@ -0,0 +1,173 @@
+#include <array>
+#include <cmath>
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CURVE_LENGTH_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+// 8-point Gauss-Legendre on [-1, 1], the nodes and weights of the positive half
+constexpr u32 NUM_GAUSS_POINTS = 8;
+constexpr f64 GAUSS_NODES[NUM_GAUSS_POINTS / 2] = {
+    0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363};
+constexpr f64 GAUSS_WEIGHTS[NUM_GAUSS_POINTS / 2] = {
+    0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+
+// the fallback blend's speed dips to zero at its tip on sharp turns, a kink no single polynomial rule follows
+constexpr u32 NUM_FALLBACK_PANELS = 8;
+
+// node on [0, 1] with the weight of its panel folded in, and the sine and cosine CalcCorrectedDist takes there
+struct CQuadratureNode
+{
+    f32 Time;
+    f32 Weight;
+    f32 SinHalf;  // sin(PI * Time)
+    f32 CosHalf;  // cos(PI * Time)
+};
+
+template <u32 NUM_PANELS>
+constexpr std::array<CQuadratureNode, NUM_PANELS * NUM_GAUSS_POINTS> MakeQuadratureNodes()
+{
+    std::array<CQuadratureNode, NUM_PANELS * NUM_GAUSS_POINTS> nodes = {};
+    for (u32 panel = 0; panel < NUM_PANELS; panel++)
+    {
+        for (u32 i = 0; i < NUM_GAUSS_POINTS; i++)
+        {
+            const f64 node = i < NUM_GAUSS_POINTS / 2 ? -GAUSS_NODES[i] : GAUSS_NODES[i - NUM_GAUSS_POINTS / 2];
+            const f64 weight = GAUSS_WEIGHTS[i % (NUM_GAUSS_POINTS / 2)];
+            const f32 Time = static_cast<f32>((panel + (node + 1.0) * 0.5) / NUM_PANELS);
+
+            nodes[panel * NUM_GAUSS_POINTS + i] = {Time, static_cast<f32>(weight * 0.5 / NUM_PANELS),
+                CMaths::Sin(Time * PI), CMaths::Cos(Time * PI)};
+        }
+    }
+    return nodes;
+}
+
+constexpr auto FALLBACK_NODES = MakeQuadratureNodes<NUM_FALLBACK_PANELS>();
+
+// Integral of |P + D * t| over t in [0, 1]. With t0 where the speed is smallest and h the speed there, the speed is
+// sqrt(s^2 + h^2) over s = |D| * (t - t0), whose integral over t is (s * sqrt(s^2 + h^2) + h^2 * asinh(s / h)) / 2|D|.
+f32 IntegrateLinearSpeed(const CVector& P, const CVector& D)
+{
+    const f64 DSqr = static_cast<f64>(D.x) * D.x + static_cast<f64>(D.y) * D.y + static_cast<f64>(D.z) * D.z;
+    if (DSqr < 1e-12)
+    {
+        return P.Magnitude();
+    }
+
+    // cross product for the offset, subtracting the squares would cancel on near-straight bends
+    const f64 cx = static_cast<f64>(P.y) * D.z - static_cast<f64>(P.z) * D.y;
+    const f64 cy = static_cast<f64>(P.z) * D.x - static_cast<f64>(P.x) * D.z;
+    const f64 cz = static_cast<f64>(P.x) * D.y - static_cast<f64>(P.y) * D.x;
+    const f64 hSqr = (cx * cx + cy * cy + cz * cz) / DSqr;
+    const f64 h = std::sqrt(hSqr);
+
+    const f64 DLength = std::sqrt(DSqr);
+    const f64 t0 = -(static_cast<f64>(P.x) * D.x + static_cast<f64>(P.y) * D.y + static_cast<f64>(P.z) * D.z) / DSqr;
+
+    const auto Antiderivative = [&](f64 s)
+    {
+        return s * std::sqrt(s * s + hSqr) + (h > 0.0 ? hSqr * std::asinh(s / h) : 0.0);
+    };
+    const f64 length = (Antiderivative(DLength * (1.0 - t0)) - Antiderivative(-DLength * t0)) / (2.0 * DLength);
+    return static_cast<f32>(length);
+}
+
+// The bend blend (BendStart + StartDir * B * t) * (1 - t) + (BendEnd - EndDir * B * (1 - t)) * t of CalcCurvePoint
+// moves with the velocity L - 2 * K * t over BendInter t, see FindClosestTime.
+f32 CalcBendLength(const CCurveSegment& segment)
+{
+    const CVector bendStart = segment.StartCoors + segment.StartDir * segment.StraightDist1;
+    const CVector bendEnd = segment.EndCoors - segment.EndDir * segment.StraightDist2;
+    const CVector K = (segment.StartDir - segment.EndDir) * segment.BendDistOneSegment;
+    return IntegrateLinearSpeed(bendEnd - bendStart + K, K * -2.0f);
+}
+
+// CalcCorrectedDist gives the distance c and the interpolation value i the fallback blend
+// Ps(c) * (1 - i) + Pe(c) * i moves with, its velocity over Time is (StartDir * (1 - i) + EndDir * i) * c' +
+// (Pe(c) - Ps(c)) * i'
+f32 CalcFallbackLength(const CCurveSegment& segment)
+{
+    const f32 BendDist = segment.BendDist;
+    const f32 SpeedVariation = segment.SpeedVariation;
+
+    // CalcCorrectedDist parks the blend at the midpoint of the two rays' starts
+    if (BendDist < 0.00001f)
+    {
+        return 0.0f;
+    }
+
+    // squared speeds first, that loop vectorizes; std::sqrt's errno keeps the compiler from doing it in one go
+    f32 speedSqr[FALLBACK_NODES.size()];
+    for (u32 i = 0; i < FALLBACK_NODES.size(); i++)
+    {
+        const CQuadratureNode& node = FALLBACK_NODES[i];
+        const f32 sinFull = 2.0f * node.SinHalf * node.CosHalf;
+        const f32 cosFull = 1.0f - 2.0f * node.SinHalf * node.SinHalf;
+
+        const f32 Interpol = 0.5f - node.CosHalf * 0.5f;
+        const f32 CurrentDist_Time =
+            (1.0f - SpeedVariation) * BendDist * node.Time + (BendDist / TWO_PI) * SpeedVariation * sinFull;
+        const f32 distRate = BendDist * ((1.0f - SpeedVariation) + SpeedVariation * cosFull);
+        const f32 interpolRate = HALF_PI * node.SinHalf;
+
+        const CVector startPoint = segment.StartCoors + segment.StartDir * CurrentDist_Time;
+        const CVector endPoint = segment.EndCoors + segment.EndDir * (CurrentDist_Time - segment.StraightDist);
+        const CVector velocity = (segment.StartDir * (1.0f - Interpol) + segment.EndDir * Interpol) * distRate +
+                                 (endPoint - startPoint) * interpolRate;
+
+        speedSqr[i] = velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z;
+    }
+
+#ifdef CURVE_LENGTH_SSE
+    static_assert(FALLBACK_NODES.size() % 4 == 0);
+    __m128 sum = _mm_setzero_ps();
+    for (u32 i = 0; i < FALLBACK_NODES.size(); i += 4)
+    {
+        const __m128 weights = _mm_setr_ps(FALLBACK_NODES[i].Weight, FALLBACK_NODES[i + 1].Weight,
+            FALLBACK_NODES[i + 2].Weight, FALLBACK_NODES[i + 3].Weight);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_sqrt_ps(_mm_loadu_ps(&speedSqr[i])), weights));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+#else
+    f32 length = 0.0f;
+    for (u32 i = 0; i < FALLBACK_NODES.size(); i++)
+    {
+        length += CMaths::Sqrt(speedSqr[i]) * FALLBACK_NODES[i].Weight;
+    }
+    return length;
+#endif
+}
+}  // namespace
+
+f32 CCurves::CalcCurveLength(const CCurveSegment& segment)
+{
+    if (!segment.bCrossing)
+    {
+        return CalcFallbackLength(segment);
+    }
+
+    return segment.StartDir.Magnitude() * segment.StraightDist1 + CalcBendLength(segment) +
+           segment.EndDir.Magnitude() * segment.StraightDist2;
+}
+
+void CCurves::CalcCurveLength(
+    const CVector& startCoors, const CVector& endCoors, const CVector& startDir, const CVector& endDir, f32* pLength)
+{
+    *pLength = CalcCurveLength(CCurveSegment(startCoors, endCoors, startDir, endDir));
+}
+
+void CCurves::CalcCurveLengths(const CCurveSegment* pSegments, u32 Count, f32* pLengths)
+{
+    for (u32 i = 0; i < Count; i++)
+    {
+        pLengths[i] = CalcCurveLength(pSegments[i]);
+    }
+}
@@ -0,0 +1,111 @@
+#include <cstdint>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "curve_mapped_file.hpp"
+
+CCurveMappedFile::~CCurveMappedFile()
+{
+    Close();
+}
+
+bool CCurveMappedFile::Open(const char* pPath, eAccess Access)
+{
+    Close();
+
+#ifdef _WIN32
+    const DWORD flags = Access == ACCESS_SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : 0;
+    HANDLE hFile = CreateFileA(
+        pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(hFile, &size) || static_cast<u64>(size.QuadPart) > SIZE_MAX || size.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* pData = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!pData)
+    {
+        if (hMapping)
+        {
+            CloseHandle(hMapping);
+        }
+        CloseHandle(hFile);
+        return false;
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_Size = static_cast<u64>(size.QuadPart);
+#else
+    const int fd = open(pPath, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<u64>(info.st_size) > SIZE_MAX || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* pData = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pData == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(pData, static_cast<size_t>(info.st_size), Access == ACCESS_SEQUENTIAL ? MADV_SEQUENTIAL : MADV_WILLNEED);
+
+    m_Size = static_cast<u64>(info.st_size);
+#endif
+    m_pData = static_cast<const char*>(pData);
+    return true;
+}
+
+void CCurveMappedFile::Close()
+{
+    if (!m_pData)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_pData);
+    CloseHandle(m_hMapping);
+    CloseHandle(m_hFile);
+    m_hMapping = nullptr;
+    m_hFile = nullptr;
+#else
+    munmap(const_cast<char*>(m_pData), static_cast<size_t>(m_Size));
+#endif
+
+    m_pData = nullptr;
+    m_Size = 0;
+}
+
+bool CCurveMappedFile::WritePadding(FILE* pFile, u64& Written, u64 Offset)
+{
+    const char padding[SECTION_ALIGNMENT] = {};
+    const u64 size = Offset - Written;
+    Written = Offset;
+    return std::fwrite(padding, 1, size, pFile) == size;
+}
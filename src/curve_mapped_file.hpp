@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdio>
+
+#include "curves.hpp"
+
+/// Read-only memory mapping of a whole file, for the formats that are read straight out of the page cache
+/// (`CCurveCorpus`, `CCurveNetwork` node files).
+///
+/// Those formats are their structs written out as they are, so the struct layouts are the file format and their
+/// sizes are pinned with `static_assert`s: padding would make a file depend on the compiler that wrote it. Their
+/// sections start on `SECTION_ALIGNMENT`, the writers pad up to it with `WritePadding`.
+class CCurveMappedFile
+{
+public:
+    static constexpr u64 SECTION_ALIGNMENT = 64;
+
+    /// `Offset` rounded up to the next multiple of `SECTION_ALIGNMENT`.
+    static constexpr u64 AlignUp(u64 Offset) { return (Offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1); }
+
+    /// Writes zeros from `Written` up to `Offset`, at most `SECTION_ALIGNMENT` - 1 of them.
+    /// \param Written Bytes written to the file so far, set to `Offset`.
+    static bool WritePadding(FILE* pFile, u64& Written, u64 Offset);
+
+    /// Read-ahead hint for the mapping.
+    enum eAccess : u32
+    {
+        ACCESS_SEQUENTIAL,  // streamed front to back, pages behind the reader can go
+        ACCESS_WILL_NEED,   // all of it soon and in any order, read ahead the whole file
+    };
+
+    CCurveMappedFile() {}
+    ~CCurveMappedFile();
+
+    CCurveMappedFile(const CCurveMappedFile&) = delete;
+    CCurveMappedFile& operator=(const CCurveMappedFile&) = delete;
+
+    /// Maps `pPath`, closing the file mapped before.
+    /// \return false if the file can't be opened, is empty or doesn't fit the address space.
+    bool Open(const char* pPath, eAccess Access = ACCESS_SEQUENTIAL);
+    void Close();
+
+    bool IsOpen() const { return m_pData != nullptr; }
+    const char* GetData() const { return m_pData; }
+    u64 GetSize() const { return m_Size; }
+
+private:
+    const char* m_pData = nullptr;
+    u64 m_Size = 0;
+#ifdef _WIN32
+    void* m_hFile = nullptr;
+    void* m_hMapping = nullptr;
+#endif
+};
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CURVE_MATH_SSE 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CURVE_MATH_SSE2 1
+#endif
+
+#include "curve_stats.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+#include "vector_simd.hpp"
+
+/// Precision policy of `CCurveMathT` reproducing the game's results, every operation is the plain one.
+struct CCurveExact
+{
+    static constexpr f32 Div(f32 a, f32 b) { return a / b; }
+    static constexpr f32 MulAdd(f32 a, f32 b, f32 c) { return a * b + c; }
+    static constexpr f32 Sin(f32 x) { return CMaths::Sin(x); }
+    static constexpr f32 Cos(f32 x) { return CMaths::Cos(x); }
+};
+
+/// Precision policy of `CCurveMathT` for results that don't need to be bit-exact (traffic far from the camera).
+///
+/// Divides through the SSE reciprocal estimate plus one Newton-Raphson step (about 1 ulp), zero and denormal divisors
+/// go through the plain divide (the estimate is inf there, the Newton step would turn it into NaN). Uses fused
+/// multiply-add when the target has it and evaluates sine and cosine with `CMaths::FastSin` / `CMaths::FastCos`
+/// inside their valid ranges. During constant evaluation it falls back to `CCurveExact`.
+///
+/// The 2D cross products deciding whether the rays cross stay plain multiplies: for nearly opposite directions they
+/// cancel down to rounding noise, and fusing them would flip curves between the crossing and the fallback path.
+struct CCurveFast
+{
+    static constexpr f32 Div(f32 a, f32 b)
+    {
+#ifdef CURVE_MATH_SSE
+        if !consteval
+        {
+            if (std::fabs(b) >= std::numeric_limits<f32>::min())
+            {
+                const f32 r = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(b)));
+                return a * (r * (2.0f - b * r));
+            }
+        }
+#endif
+        return a / b;
+    }
+
+    static constexpr f32 MulAdd(f32 a, f32 b, f32 c)
+    {
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+        if !consteval
+        {
+            return std::fma(a, b, c);
+        }
+#endif
+        return a * b + c;
+    }
+
+    static constexpr f32 Sin(f32 x)
+    {
+        if consteval
+        {
+            return CMaths::Sin(x);
+        }
+        else
+        {
+            return x >= 0.0f && x <= TWO_PI ? CMaths::FastSin(x) : CMaths::Sin(x);
+        }
+    }
+
+    static constexpr f32 Cos(f32 x)
+    {
+        if consteval
+        {
+            return CMaths::Cos(x);
+        }
+        else
+        {
+            return x >= 0.0f && x <= PI ? CMaths::FastCos(x) : CMaths::Cos(x);
+        }
+    }
+};
+
+/// The custom implementation of the `CCurves` math, header-only and constexpr, over a precision policy.
+///
+/// `CCurves` forwards here when built with `USE_CUSTOM_IMPL`, using `CCurveExact` (or `CCurveFast` with
+/// `USE_FAST_TRIG`). Including this header directly lets the math inline into the caller, lets fixed curves (scripted
+/// camera paths, test fixtures) be folded at compile time and lets callers pick the precision per call site. See the
+/// `CCurves` declarations for what every function does.
+///
+/// Worst-case deviation of `CCurveFast` from `CCurveExact` is printed by the `curves-precision` tool.
+template <typename Precision>
+class CCurveMathT
+{
+public:
+    // fn @ 0x43C610
+    static constexpr f32 DistForLineToCrossOtherLine(f32 LineBaseX, f32 LineBaseY, f32 LineDirX, f32 LineDirY,
+        f32 OtherLineBaseX, f32 OtherLineBaseY, f32 OtherLineDirX, f32 OtherLineDirY)
+    {
+        CURVE_STAT_COUNT(DIST_FOR_LINE_CALLS);
+
+        f32 Dir = LineDirX * OtherLineDirY - LineDirY * OtherLineDirX;
+
+        if (Dir == 0.0f)
+        {
+            CURVE_STAT_COUNT(DIST_FOR_LINE_PARALLEL);
+            return -1.0f;  // Lines are parallel, no intersection
+        }
+
+        f32 Dist = ((LineBaseX - OtherLineBaseX) * OtherLineDirY) - ((LineBaseY - OtherLineBaseY) * OtherLineDirX);
+        f32 DistOfCrossing = Precision::Div(-Dist, Dir);
+
+        return DistOfCrossing;
+    }
+
+    // fn @ 0x43C660
+    static constexpr f32 CalcSpeedVariationInBend(
+        const CVector& startCoors, const CVector& endCoors, f32 StartDirX, f32 StartDirY, f32 EndDirX, f32 EndDirY)
+    {
+        f32 ReturnVal = 0.0f;
+        f32 DotProduct = StartDirX * EndDirX + StartDirY * EndDirY;
+        CURVE_STAT_RECORD(HISTOGRAM_DOT_PRODUCT, DotProduct);
+
+        if (DotProduct <= 0.0f)
+        {
+            CURVE_STAT_COUNT(SPEED_VARIATION_DOT_BELOW_ZERO);
+
+            // If the dot product is <= 0, return a constant value (1/3)
+            ReturnVal = 1.0f / 3.0f;
+        }
+        else if (DotProduct <= 0.7f)
+        {
+            CURVE_STAT_COUNT(SPEED_VARIATION_DOT_BELOW_0_7);
+
+            // If the dot product is <= 0.7, interpolate the return value
+            ReturnVal = (1.0f - (DotProduct / 0.7f)) * (1.0f / 3.0f);
+        }
+        else
+        {
+            CURVE_STAT_COUNT(SPEED_VARIATION_DOT_ABOVE_0_7);
+
+            // Calculate the distance from the start point to the mathematical line defined by the end point and
+            // direction
+            f32 DistToLine = CCollision::DistToMathematicalLine2D(
+                endCoors.x, endCoors.y, EndDirX, EndDirY, startCoors.x, startCoors.y);
+
+            // Calculate the straight-line distance between the start and end points
+            f32 StraightDist = Magnitude2D(startCoors - endCoors);
+
+            // Normalize the distance to the line by the straight-line distance
+            ReturnVal = Precision::Div(DistToLine, StraightDist) * (1.0f / 3.0f);
+        }
+
+        return ReturnVal;
+    }
+
+    // fn @ 0x43C710
+    static constexpr f32 CalcSpeedScaleFactor(
+        const CVector& startCoors, const CVector& endCoors, f32 StartDirX, f32 StartDirY, f32 EndDirX, f32 EndDirY)
+    {
+        f32 SpeedVariation = CalcSpeedVariationInBend(startCoors, endCoors, StartDirX, StartDirY, EndDirX, EndDirY);
+
+        // Calculate intersection distances using helper function
+        f32 DistToPoint1 = DistForLineToCrossOtherLine(
+            startCoors.x, startCoors.y, StartDirX, StartDirY, endCoors.x, endCoors.y, EndDirX, EndDirY);
+
+        // yes the negation (-) is intentional
+        f32 DistToPoint2 = -DistForLineToCrossOtherLine(
+            endCoors.x, endCoors.y, EndDirX, EndDirY, startCoors.x, startCoors.y, StartDirX, StartDirY);
+
+        if (DistToPoint1 <= 0.0f || DistToPoint2 <= 0.0f)
+        {
+            CURVE_STAT_COUNT(SCALE_FACTOR_FALLBACK);
+
+            // Calculate straight line distance
+            f32 StraightDist = Magnitude2D(startCoors - endCoors);
+            return Precision::Div(StraightDist, 1.0f - SpeedVariation);
+        }
+
+        CURVE_STAT_COUNT(SCALE_FACTOR_CROSSING);
+
+        // clamp bend distance to 5.0f
+        f32 BendDistOneSegment = CMaths::Min(CMaths::Min(DistToPoint1, DistToPoint2), 5.0f);
+
+        const f32 StartDirYa = DistToPoint1 - BendDistOneSegment;
+        const f32 EndDirYa = DistToPoint2 - BendDistOneSegment;
+
+        f32 BendDist = BendDistOneSegment * 2.0f + StartDirYa + EndDirYa;
+        f32 TotalDist_Time = BendDist;
+        return TotalDist_Time;
+    }
+
+    // fn @ 0x43C880
+    static constexpr f32 CalcCorrectedDist(f32 Current, f32 Total, f32 SpeedVariation, f32* pInterPol)
+    {
+        CURVE_STAT_COUNT(CORRECTED_DIST_CALLS);
+
+        if (Total >= 0.00001f)
+        {
+            f32 AverageSpeed = (Total / TWO_PI) * SpeedVariation;
+            f32 CorrectedDist = Precision::MulAdd(AverageSpeed, Precision::Sin(Precision::Div(Current * TWO_PI, Total)),
+                ((SpeedVariation * -2.0f) + 2.0f) * 0.5f * Current);
+            *pInterPol = 0.5f - (Precision::Cos(Precision::Div(Current, Total) * PI) * 0.5f);
+            return CorrectedDist;
+        }
+
+        CURVE_STAT_COUNT(CORRECTED_DIST_ZERO_TOTAL);
+
+        *pInterPol = 0.5f;
+        return 0.0f;
+    }
+
+    // fn @ 0x43C900
+    static constexpr void CalcCurvePoint(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+        const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed)
+    {
+        // This function calculates a point on a smooth curve between two positions with direction vectors.
+        // The curve consists of straight segments and a bend connecting them for natural-looking movement.
+
+        // Normalize time parameter to ensure calculations remain within valid range
+        f32 OurTime = VCLAMP(0.0f, 1.0f, Time);
+
+        CURVE_STAT_RECORD(HISTOGRAM_CURVE_POINT_TIME, Time);
+        if (OurTime != Time)
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_TIME_CLAMPED);
+        }
+
+        // Get speed adjustment factor needed for realistic bends (slower in curves, faster on straights)
+        f32 SpeedVariation =
+            CalcSpeedVariationInBend(startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+
+        // Find where the ray from start position would intersect with end ray
+        f32 DistToPoint1 = DistForLineToCrossOtherLine(
+            startCoors.x, startCoors.y, startDir.x, startDir.y, endCoors.x, endCoors.y, endDir.x, endDir.y);
+
+        // Find where the ray from end position would intersect with start ray (negative because direction is flipped)
+        f32 DistToPoint2 = -DistForLineToCrossOtherLine(
+            endCoors.x, endCoors.y, endDir.x, endDir.y, startCoors.x, startCoors.y, startDir.x, startDir.y);
+
+        // Packed copies for the vector math below, one SSE register each
+        const CVectorSimd StartCoors(startCoors);
+        const CVectorSimd EndCoors(endCoors);
+        const CVectorSimd StartDir(startDir);
+        const CVectorSimd EndDir(endDir);
+
+        if (DistToPoint1 <= 0.0f || DistToPoint2 <= 0.0f)
+        {
+            // If rays don't intersect properly, fall back to a simpler curved path approximation
+            // This happens when the directions would never cross or are almost parallel
+
+            const f32 StraightDist = (StartCoors - EndCoors).Magnitude2D();
+            CURVE_STAT_COUNT(CURVE_POINT_FALLBACK);
+            CURVE_STAT_RECORD(HISTOGRAM_STRAIGHT_DIST, StraightDist);
+
+            // Calculate path distances adjusted for speed variation
+            f32 BendDist = Precision::Div(StraightDist, 1.0f - SpeedVariation);
+            f32 BendDist_Time = BendDist * OurTime;
+            f32 CurrentDist_Time = CalcCorrectedDist(BendDist_Time, BendDist, SpeedVariation, &SpeedVariation);
+
+            // Calculate position along start ray
+            const CVectorSimd startPoint = StartCoors + (StartDir * CurrentDist_Time);
+
+            // Calculate position along end ray
+            const f32 distDiff = CurrentDist_Time - StraightDist;
+            const CVectorSimd endPoint = EndCoors + (EndDir * distDiff);
+
+            // Blend between the two projected positions based on speed variation
+            f32 Interpol = 1.0f - SpeedVariation;
+
+            resultCoor = (startPoint * Interpol) + (endPoint * SpeedVariation);
+
+            // Zero speed for this special case (likely a placeholder as this value isn't used)
+            f32 TotalDist_Time = 0.0f;
+            const f32 timeScale = static_cast<f32>(TraverselTimeInMillis) * 0.001f;
+            const f32 t1 = 1.0f - OurTime;
+
+            resultSpeed = ((EndDir * OurTime) + (StartDir * t1)) * Precision::Div(TotalDist_Time, timeScale);
+            resultSpeed.z = 0.0f;
+
+            return;
+        }
+
+        // For properly intersecting rays, create a three-segment path:
+        // 1. Straight segment from start
+        // 2. Curved bend in the middle
+        // 3. Straight segment to end
+
+        // Limit how sharp the bend can be for natural movement
+        f32 BendDistOneSegment = CMaths::Min(CMaths::Min(DistToPoint1, DistToPoint2), 5.0f);
+
+        // Calculate the three segment lengths
+        f32 StraightDist1 = DistToPoint1 - BendDistOneSegment;
+        f32 StraightDist2 = DistToPoint2 - BendDistOneSegment;
+        f32 BendDist = BendDistOneSegment * 2.0f;
+        f32 TotalDist_Time = StraightDist1 + BendDist + StraightDist2;
+
+        const f32 distanceAtTime = TotalDist_Time * OurTime;
+
+        CURVE_STAT_RECORD(HISTOGRAM_STRAIGHT_DIST, Magnitude2D(startCoors - endCoors));
+
+        if (distanceAtTime < StraightDist1)
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_FIRST_STRAIGHT);
+
+            // Position is on the first straight segment (linear interpolation from start)
+            resultCoor = StartCoors + (StartDir * distanceAtTime);
+        }
+        else if (distanceAtTime > (StraightDist1 + BendDist))
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_SECOND_STRAIGHT);
+
+            // Position is on the final straight segment (linear interpolation to end)
+            const f32 secondSegmentDist = distanceAtTime - (StraightDist1 + BendDist);
+            resultCoor = EndCoors + (EndDir * secondSegmentDist);
+        }
+        else
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_BEND);
+
+            // Position is in the curved bend section - requires double interpolation
+            // First interpolate through the bend progress, then between the influenced points
+            f32 BendInter = Precision::Div(distanceAtTime - StraightDist1, BendDist);
+
+            // Find the start point of the bend
+            CVectorSimd BendStartCoors = StartCoors + (StartDir * StraightDist1);
+
+            // Find the end point of the bend
+            CVectorSimd BendEndCoors = EndCoors - (EndDir * StraightDist2);
+
+            // Create smooth transition by double-interpolating between the bend points
+            const f32 oneMinusBendInter = 1.0f - BendInter;
+
+            // Create influence points that extend outward from the bend endpoints
+            const CVectorSimd startInfluence = BendStartCoors + (StartDir * (BendDistOneSegment * BendInter));
+            const CVectorSimd endInfluence = BendEndCoors - (EndDir * (BendDistOneSegment * oneMinusBendInter));
+
+            // Blend between influence points to create curved path
+            resultCoor = (startInfluence * oneMinusBendInter) + (endInfluence * BendInter);
+        }
+
+        // Calculate velocity based on blend of start/end directions and total path length
+        const f32 timeScale = static_cast<f32>(TraverselTimeInMillis) * 0.001f;
+        const f32 t1 = 1.0f - OurTime;
+
+        resultSpeed = ((EndDir * OurTime) + (StartDir * t1)) * Precision::Div(TotalDist_Time, timeScale);
+        resultSpeed.z = 0.0f;
+    }
+
+    // CalcCurvePoint with every path computed and the results selected, bit-identical to it. The divisors of the
+    // paths not taken are replaced by 1 so nothing divides by zero (which also keeps it a constant expression).
+    static constexpr void CalcCurvePointBranchless(const CVector& startCoors, const CVector& endCoors,
+        const CVector& startDir, const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor,
+        CVector& resultSpeed)
+    {
+        // VCLAMP as selects, std::min / std::max compile to branches here (so does CMaths::Min further down)
+        const f32 TimeAboveZero = Select(Time < 0.0f, 0.0f, Time);
+        const f32 OurTime = Select(1.0f < TimeAboveZero, 1.0f, TimeAboveZero);
+
+        const CVectorSimd StartCoors(startCoors);
+        const CVectorSimd EndCoors(endCoors);
+        const CVectorSimd StartDir(startDir);
+        const CVectorSimd EndDir(endDir);
+
+        const f32 StraightDist = (StartCoors - EndCoors).Magnitude2D();
+
+        // CalcSpeedVariationInBend, all three cases
+        const f32 DotProduct = startDir.x * endDir.x + startDir.y * endDir.y;
+        const bool bDotAbove07 = DotProduct > 0.7f;
+        // CCollision::DistToMathematicalLine2D
+        const f32 px = startCoors.x - endCoors.x;
+        const f32 py = startCoors.y - endCoors.y;
+        const f32 LineDot = px * endDir.x + py * endDir.y;
+        const f32 DistSq = px * px + py * py - LineDot * LineDot;
+        const f32 DistToLine = CMaths::Sqrt(Select(DistSq <= 0.0f, 0.0f, DistSq));
+        const f32 VariationAbove07 =
+            Precision::Div(DistToLine, Select(bDotAbove07, StraightDist, 1.0f)) * (1.0f / 3.0f);
+        const f32 VariationBelow07 = (1.0f - (DotProduct / 0.7f)) * (1.0f / 3.0f);
+        const f32 SpeedVariation =
+            Select(DotProduct <= 0.0f, 1.0f / 3.0f, Select(bDotAbove07, VariationAbove07, VariationBelow07));
+
+        // DistForLineToCrossOtherLine both ways, the cross product is the same for both up to its sign
+        const f32 Dir = startDir.x * endDir.y - startDir.y * endDir.x;
+        const f32 OtherDir = endDir.x * startDir.y - endDir.y * startDir.x;
+        const bool bParallel = Dir == 0.0f;
+        const f32 Dist1 = ((startCoors.x - endCoors.x) * endDir.y) - ((startCoors.y - endCoors.y) * endDir.x);
+        const f32 Dist2 = ((endCoors.x - startCoors.x) * startDir.y) - ((endCoors.y - startCoors.y) * startDir.x);
+        const f32 DistToPoint1 = Select(bParallel, -1.0f, Precision::Div(-Dist1, Select(bParallel, 1.0f, Dir)));
+        const f32 DistToPoint2 =
+            -Select(OtherDir == 0.0f, -1.0f, Precision::Div(-Dist2, Select(OtherDir == 0.0f, 1.0f, OtherDir)));
+
+        // not ||, which would be a branch of its own
+        const bool bFallback = (DistToPoint1 <= 0.0f) | (DistToPoint2 <= 0.0f);
+
+        // Fallback path, CalcCorrectedDist inlined with its Total < 0.00001 case selected
+        const f32 FallbackDist = Precision::Div(StraightDist, 1.0f - SpeedVariation);
+        const f32 FallbackDist_Time = FallbackDist * OurTime;
+        const bool bZeroTotal = !(FallbackDist >= 0.00001f);
+        const f32 SafeTotal = Select(bZeroTotal, 1.0f, FallbackDist);
+        const f32 AverageSpeed = (SafeTotal / TWO_PI) * SpeedVariation;
+        const f32 CorrectedDist = Precision::MulAdd(AverageSpeed,
+            Precision::Sin(Precision::Div(FallbackDist_Time * TWO_PI, SafeTotal)),
+            ((SpeedVariation * -2.0f) + 2.0f) * 0.5f * FallbackDist_Time);
+        const f32 CurrentDist_Time = Select(bZeroTotal, 0.0f, CorrectedDist);
+        const f32 Blend = Select(bZeroTotal, 0.5f,
+            0.5f - (Precision::Cos(Precision::Div(FallbackDist_Time, SafeTotal) * PI) * 0.5f));
+
+        const CVectorSimd startPoint = StartCoors + (StartDir * CurrentDist_Time);
+        const CVectorSimd endPoint = EndCoors + (EndDir * (CurrentDist_Time - StraightDist));
+        const CVectorSimd FallbackCoor = (startPoint * (1.0f - Blend)) + (endPoint * Blend);
+
+        // Crossing path, all three sections
+        const f32 MinDistToPoint = Select(DistToPoint2 < DistToPoint1, DistToPoint2, DistToPoint1);
+        const f32 BendDistOneSegment = Select(5.0f < MinDistToPoint, 5.0f, MinDistToPoint);
+        const f32 StraightDist1 = DistToPoint1 - BendDistOneSegment;
+        const f32 StraightDist2 = DistToPoint2 - BendDistOneSegment;
+        const f32 BendDist = BendDistOneSegment * 2.0f;
+        const f32 CrossingDist = StraightDist1 + BendDist + StraightDist2;
+        const f32 distanceAtTime = CrossingDist * OurTime;
+
+        const CVectorSimd FirstStraightCoor = StartCoors + (StartDir * distanceAtTime);
+        const CVectorSimd SecondStraightCoor = EndCoors + (EndDir * (distanceAtTime - (StraightDist1 + BendDist)));
+
+        const f32 BendInter = Precision::Div(distanceAtTime - StraightDist1, Select(bFallback, 1.0f, BendDist));
+        const f32 oneMinusBendInter = 1.0f - BendInter;
+        const CVectorSimd BendStartCoors = StartCoors + (StartDir * StraightDist1);
+        const CVectorSimd BendEndCoors = EndCoors - (EndDir * StraightDist2);
+        const CVectorSimd startInfluence = BendStartCoors + (StartDir * (BendDistOneSegment * BendInter));
+        const CVectorSimd endInfluence = BendEndCoors - (EndDir * (BendDistOneSegment * oneMinusBendInter));
+        const CVectorSimd BendCoor = (startInfluence * oneMinusBendInter) + (endInfluence * BendInter);
+
+        const CVectorSimd CrossingCoor = Select(distanceAtTime < StraightDist1, FirstStraightCoor,
+            Select(distanceAtTime > (StraightDist1 + BendDist), SecondStraightCoor, BendCoor));
+        resultCoor = Select(bFallback, FallbackCoor, CrossingCoor);
+
+        // The fallback path has no speed
+        const f32 TotalDist_Time = Select(bFallback, 0.0f, CrossingDist);
+        const f32 timeScale = static_cast<f32>(TraverselTimeInMillis) * 0.001f;
+        const f32 t1 = 1.0f - OurTime;
+
+        resultSpeed = ((EndDir * OurTime) + (StartDir * t1)) * Precision::Div(TotalDist_Time, timeScale);
+        resultSpeed.z = 0.0f;
+    }
+
+private:
+    // bCondition ? a : b on values that are already computed. Written as a mask and blend at runtime, compilers turn
+    // the plain ternary on floats back into a branch.
+    static constexpr f32 Select(bool bCondition, f32 a, f32 b)
+    {
+#ifdef CURVE_MATH_SSE2
+        if !consteval
+        {
+            const __m128 mask = _mm_castsi128_ps(_mm_cvtsi32_si128(-static_cast<i32>(bCondition)));
+            return _mm_cvtss_f32(_mm_or_ps(_mm_and_ps(mask, _mm_set_ss(a)), _mm_andnot_ps(mask, _mm_set_ss(b))));
+        }
+#endif
+        return bCondition ? a : b;
+    }
+
+    static constexpr CVectorSimd Select(bool bCondition, const CVectorSimd& a, const CVectorSimd& b)
+    {
+#ifdef CURVE_MATH_SSE2
+        if !consteval
+        {
+            const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-static_cast<i32>(bCondition)));
+            return CVectorSimd(_mm_or_ps(_mm_and_ps(mask, a.Get()), _mm_andnot_ps(mask, b.Get())));
+        }
+#endif
+        return bCondition ? a : b;
+    }
+
+    // CVector::Magnitude2D, which can't be constexpr itself without pulling CMaths into curves.hpp
+    static constexpr f32 Magnitude2D(const CVector& v) { return CMaths::Sqrt(v.x * v.x + v.y * v.y); }
+};
+
+using CCurveMath = CCurveMathT<CCurveExact>;
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "curve_network.hpp"
+#include "curve_thread_pool.hpp"
+#include "maths.hpp"
+
+namespace
+{
+constexpr char MAGIC[8] = {'C', 'R', 'V', 'N', 'O', 'D', 'E', 'S'};
+
+// links written at once by WriteSyntheticNodeFile, and built at once by a pool thread
+constexpr u32 LINKS_PER_BLOCK = 1 << 16;
+constexpr u32 LINKS_PER_CHUNK = 4096;
+
+// synthetic networks, grid spacing and how far the nodes stray off it
+constexpr f32 NODE_SPACING = 40.0f;
+constexpr f32 NODE_JITTER = 8.0f;
+
+// the file format, see CCurveMappedFile
+static_assert(sizeof(CVector) == 12);
+static_assert(sizeof(CCurveNetwork::CLink) == 24);
+static_assert(sizeof(CCurveNetwork::CHeader) == 40);
+
+// path node positions are stored in 1/8 units
+f32 Quantize(f32 Value)
+{
+    return std::round(Value * 8.0f) * (1.0f / 8.0f);
+}
+
+struct CBuildJob
+{
+    const CVector* pNodes;
+    const CCurveNetwork::CLink* pLinks;
+    u32 NumNodes;
+    u32 NumLinks;
+    CCurveSegment* pCurves;
+    f32* pLengths;
+    std::atomic<bool> bBadLink;
+};
+
+void BuildChunk(void* pContext, u32 Chunk)
+{
+    CBuildJob& job = *static_cast<CBuildJob*>(pContext);
+    const u32 begin = Chunk * LINKS_PER_CHUNK;
+    const u32 end = std::min(begin + LINKS_PER_CHUNK, job.NumLinks);
+
+    for (u32 i = begin; i < end; i++)
+    {
+        const CCurveNetwork::CLink& link = job.pLinks[i];
+        if (link.StartNode >= job.NumNodes || link.EndNode >= job.NumNodes)
+        {
+            job.bBadLink.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        job.pCurves[i] = CCurveSegment(job.pNodes[link.StartNode], job.pNodes[link.EndNode],
+            CVector(link.StartDirX, link.StartDirY, 0.0f), CVector(link.EndDirX, link.EndDirY, 0.0f));
+    }
+    CCurves::CalcCurveLengths(job.pCurves + begin, end - begin, job.pLengths + begin);
+}
+}  // namespace
+
+bool CCurveNetwork::WriteSyntheticNodeFile(const char* pPath, u32 NumNodes, u64 Seed)
+{
+    std::mt19937_64 rng(Seed);
+    std::uniform_real_distribution<f32> jitter(-NODE_JITTER, NODE_JITTER);
+    std::uniform_real_distribution<f32> turn(-PI / 3.0f, PI / 3.0f);
+
+    // a square grid, the last row only partly filled
+    const u32 columns = std::max(1u, static_cast<u32>(std::ceil(std::sqrt(static_cast<f64>(NumNodes)))));
+    const f32 center = static_cast<f32>(columns) * NODE_SPACING * 0.5f;
+
+    std::vector<CVector> nodes(NumNodes);
+    for (u32 i = 0; i < NumNodes; i++)
+    {
+        const f32 x = static_cast<f32>(i % columns) * NODE_SPACING - center + jitter(rng);
+        const f32 y = static_cast<f32>(i / columns) * NODE_SPACING - center + jitter(rng);
+        const f32 z = 20.0f + 15.0f * std::sin(x * (1.0f / 350.0f)) * std::cos(y * (1.0f / 275.0f));
+        nodes[i] = CVector(Quantize(x), Quantize(y), Quantize(z));
+    }
+
+    const auto HasRight = [&](u32 Node) { return Node % columns + 1 < columns && Node + 1 < NumNodes; };
+    const auto HasUp = [&](u32 Node) { return Node + columns < NumNodes; };
+
+    u32 numLinks = 0;
+    for (u32 i = 0; i < NumNodes; i++)
+    {
+        numLinks += HasRight(i) + HasUp(i);
+    }
+
+    CHeader header = {};
+    std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+    header.Version = VERSION;
+    header.NumNodes = NumNodes;
+    header.NumLinks = numLinks;
+    header.NodesOffset = CCurveMappedFile::AlignUp(sizeof(CHeader));
+    header.LinksOffset = CCurveMappedFile::AlignUp(header.NodesOffset + u64{NumNodes} * sizeof(CVector));
+    const u64 fileSize = CCurveMappedFile::AlignUp(header.LinksOffset + u64{numLinks} * sizeof(CLink));
+
+    FILE* pFile = std::fopen(pPath, "wb");
+    if (!pFile)
+    {
+        return false;
+    }
+
+    u64 written = sizeof(header);
+    bool bOk = std::fwrite(&header, sizeof(header), 1, pFile) == 1 &&
+               CCurveMappedFile::WritePadding(pFile, written, header.NodesOffset);
+    bOk = bOk && std::fwrite(nodes.data(), sizeof(CVector), NumNodes, pFile) == NumNodes;
+    written += u64{NumNodes} * sizeof(CVector);
+    bOk = bOk && CCurveMappedFile::WritePadding(pFile, written, header.LinksOffset);
+
+    // headings off the straight line between the nodes, like lanes leaving a junction at an angle
+    std::vector<CLink> block;
+    block.reserve(LINKS_PER_BLOCK + 2);
+    const auto AddLink = [&](u32 Start, u32 End)
+    {
+        const f32 heading = std::atan2(nodes[End].y - nodes[Start].y, nodes[End].x - nodes[Start].x);
+        const f32 startHeading = heading + turn(rng);
+        const f32 endHeading = heading + turn(rng);
+        block.push_back({Start, End, std::cos(startHeading), std::sin(startHeading), std::cos(endHeading),
+            std::sin(endHeading)});
+    };
+
+    for (u32 i = 0; i < NumNodes && bOk; i++)
+    {
+        if (HasRight(i))
+        {
+            AddLink(i, i + 1);
+        }
+        if (HasUp(i))
+        {
+            AddLink(i, i + columns);
+        }
+
+        if (block.size() >= LINKS_PER_BLOCK || i + 1 == NumNodes)
+        {
+            bOk = std::fwrite(block.data(), sizeof(CLink), block.size(), pFile) == block.size();
+            written += block.size() * sizeof(CLink);
+            block.clear();
+        }
+    }
+
+    // padded like the sections, the file ends on the alignment
+    bOk = bOk && CCurveMappedFile::WritePadding(pFile, written, fileSize);
+
+    return std::fclose(pFile) == 0 && bOk;
+}
+
+bool CCurveNetwork::Load(const char* pPath, CCurveThreadPool* pPool)
+{
+    Clear();
+
+    // every page is read by some chunk, in whichever order the threads get to them
+    if (!m_File.Open(pPath, CCurveMappedFile::ACCESS_WILL_NEED))
+    {
+        return false;
+    }
+    const u64 size = m_File.GetSize();
+
+    const CHeader& header = GetHeader();
+    const bool bValid = size >= sizeof(CHeader) && std::memcmp(header.Magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                        header.Version == VERSION && header.NodesOffset % CCurveMappedFile::SECTION_ALIGNMENT == 0 &&
+                        header.LinksOffset % CCurveMappedFile::SECTION_ALIGNMENT == 0 &&
+                        header.NodesOffset <= size && header.LinksOffset <= size &&
+                        header.NumNodes <= (size - header.NodesOffset) / sizeof(CVector) &&
+                        header.NumLinks <= (size - header.LinksOffset) / sizeof(CLink);
+    if (!bValid)
+    {
+        Clear();
+        return false;
+    }
+
+    m_Curves.resize(header.NumLinks);
+    m_Lengths.resize(header.NumLinks);
+
+    CBuildJob job = {GetNodes(), GetLinks(), header.NumNodes, header.NumLinks, m_Curves.data(), m_Lengths.data(),
+        false};
+    const u32 numChunks = (header.NumLinks + LINKS_PER_CHUNK - 1) / LINKS_PER_CHUNK;
+    if (pPool)
+    {
+        pPool->Run(numChunks, BuildChunk, &job);
+    }
+    else
+    {
+        for (u32 chunk = 0; chunk < numChunks; chunk++)
+        {
+            BuildChunk(&job, chunk);
+        }
+    }
+
+    if (job.bBadLink.load(std::memory_order_relaxed))
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void CCurveNetwork::Clear()
+{
+    m_File.Close();
+    m_Curves.clear();
+    m_Lengths.clear();
+}
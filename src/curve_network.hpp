@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include "curve_mapped_file.hpp"
+#include "curves.hpp"
+
+class CCurveThreadPool;
+
+/// The curves of every link of a path network, built at once from a path-node file instead of one link at a time
+/// as the AI first drives over it.
+///
+/// The node file is a `CHeader`, the node positions and the links between them, little-endian, both sections
+/// starting on a 64-byte boundary. `Load` maps it and builds a `CCurveSegment` per link, which carries the speed
+/// variation, the distances to the crossing and the split of the curve into its straights and bend, and the length
+/// `CCurves::CalcCurveLength` gives for it. The links are cut into chunks spread over a `CCurveThreadPool`.
+///
+/// Link directions are 2D like the game stores them, the curves are built with a z of 0.
+class CCurveNetwork
+{
+public:
+    static constexpr u32 VERSION = 1;
+
+    struct CLink
+    {
+        u32 StartNode;
+        u32 EndNode;
+        f32 StartDirX, StartDirY, EndDirX, EndDirY;
+    };
+
+    struct CHeader
+    {
+        char Magic[8];  // "CRVNODES"
+        u32 Version;
+        u32 NumNodes;
+        u32 NumLinks;
+        u32 Reserved;
+        u64 NodesOffset;  // from the start of the file, an array of CVector
+        u64 LinksOffset;  // from the start of the file, an array of CLink
+    };
+
+    CCurveNetwork() {}
+
+    CCurveNetwork(const CCurveNetwork&) = delete;
+    CCurveNetwork& operator=(const CCurveNetwork&) = delete;
+
+    /// Writes a node file of about `NumNodes` nodes on a jittered grid 40 units apart over rolling ground, each
+    /// linked to its right and upper neighbour with directions turned up to 60 degrees off the straight line.
+    /// \return false if the file couldn't be written.
+    static bool WriteSyntheticNodeFile(const char* pPath, u32 NumNodes, u64 Seed);
+
+    /// Maps a node file and builds the curve of every link, dropping the network loaded before.
+    /// \param pPool Builds the curves on its threads when given.
+    /// \return false if the file can't be mapped, isn't a node file of this version, is shorter than its header
+    ///         says or has a link to a node it doesn't have.
+    bool Load(const char* pPath, CCurveThreadPool* pPool = nullptr);
+    void Clear();
+
+    bool IsLoaded() const { return m_File.IsOpen(); }
+    u32 GetNumNodes() const { return IsLoaded() ? GetHeader().NumNodes : 0; }
+    u32 GetNumLinks() const { return static_cast<u32>(m_Curves.size()); }
+
+    /// The nodes and links, read out of the mapped file.
+    const CVector& GetNode(u32 Node) const { return GetNodes()[Node]; }
+    const CLink& GetLink(u32 Link) const { return GetLinks()[Link]; }
+
+    const CCurveSegment& GetCurve(u32 Link) const { return m_Curves[Link]; }
+    f32 GetLength(u32 Link) const { return m_Lengths[Link]; }
+
+    /// The curves and lengths of all links, indexed like the links of the file.
+    const CCurveSegment* GetCurves() const { return m_Curves.data(); }
+    const f32* GetLengths() const { return m_Lengths.data(); }
+
+private:
+    const CHeader& GetHeader() const { return *reinterpret_cast<const CHeader*>(m_File.GetData()); }
+    const CVector* GetNodes() const
+    {
+        return reinterpret_cast<const CVector*>(m_File.GetData() + GetHeader().NodesOffset);
+    }
+    const CLink* GetLinks() const { return reinterpret_cast<const CLink*>(m_File.GetData() + GetHeader().LinksOffset); }
+
+    CCurveMappedFile m_File;
+    std::vector<CCurveSegment> m_Curves;
+    std::vector<f32> m_Lengths;
+};
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cmath>
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// The fallback blend folds into a hairpin on sharp turns, with the ends of a span right next to each other. Spans
+// are checked against this many even steps of the whole curve as long as they hold some, so a fold isn't missed.
+constexpr u32 NUM_FALLBACK_SAMPLES = 16;
+constexpr u32 MAX_FALLBACK_DEPTH = 14;
+
+// steps of the bend at most, a tolerance of 0 would ask for infinitely many
+constexpr u32 MAX_BEND_STEPS = 1024;
+
+f32 Dot(const CVector& a, const CVector& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Squared distance of point from the chord between a and b
+f32 DistSqrToChord(const CVector& a, const CVector& b, const CVector& point)
+{
+    const CVector chord = b - a;
+    const CVector offset = point - a;
+    const f32 chordSqr = Dot(chord, chord);
+    const f32 t = chordSqr > 0.0f ? VCLAMP(0.0f, 1.0f, Dot(offset, chord) / chordSqr) : 0.0f;
+    const CVector d = offset - chord * t;
+    return Dot(d, d);
+}
+
+// Counts the points and writes the ones that fit
+class CPolylineWriter
+{
+public:
+    CPolylineWriter(CVector* pPoints, f32* pTimes, u32 MaxPoints)
+        : m_pPoints(pPoints), m_pTimes(pTimes), m_nMaxPoints(MaxPoints), m_nNumPoints(0)
+    {
+    }
+
+    void Add(f32 Time, const CVector& point)
+    {
+        if (m_nNumPoints < m_nMaxPoints)
+        {
+            if (m_pPoints)
+            {
+                m_pPoints[m_nNumPoints] = point;
+            }
+            if (m_pTimes)
+            {
+                m_pTimes[m_nNumPoints] = Time;
+            }
+        }
+        m_nNumPoints++;
+    }
+
+    u32 GetNumPoints() const { return m_nNumPoints; }
+
+private:
+    CVector* m_pPoints;
+    f32* m_pTimes;
+    u32 m_nMaxPoints;
+    u32 m_nNumPoints;
+};
+
+// The fallback blend of CalcCurvePoint, with everything not depending on Time done once
+class CFallbackBlend
+{
+public:
+    explicit CFallbackBlend(const CCurveSegment& segment)
+        : m_vecStartCoors(segment.StartCoors), m_vecStartDir(segment.StartDir),
+          m_vecEndBase(segment.EndCoors - segment.EndDir * segment.StraightDist), m_vecEndDir(segment.EndDir),
+          m_fBendDist(segment.BendDist), m_fSpeedVariation(segment.SpeedVariation)
+    {
+    }
+
+    CVector Position(f32 Time) const
+    {
+        f32 Interpol;
+        const f32 CurrentDist_Time =
+            CCurves::CalcCorrectedDist(m_fBendDist * Time, m_fBendDist, m_fSpeedVariation, &Interpol);
+        return (m_vecStartCoors + m_vecStartDir * CurrentDist_Time) * (1.0f - Interpol) +
+               (m_vecEndBase + m_vecEndDir * CurrentDist_Time) * Interpol;
+    }
+
+private:
+    CVector m_vecStartCoors;
+    CVector m_vecStartDir;
+    CVector m_vecEndBase;  // where the end ray is at a corrected distance of 0
+    CVector m_vecEndDir;
+    f32 m_fBendDist;
+    f32 m_fSpeedVariation;
+};
+
+// Splits the spans depth first from a fixed stack, so the points come out in order
+void SampleFallback(const CCurveSegment& segment, f32 Tolerance, CPolylineWriter& writer)
+{
+    struct CSpan
+    {
+        f32 StartTime, EndTime;
+        CVector Start, End;
+        u32 FirstSample;  // samples inside the span, (FirstSample, FirstSample + NumSamples)
+        u32 NumSamples;   // 0 once the span is shorter than a sample step
+        u32 Depth;
+    };
+
+    const CFallbackBlend blend(segment);
+    const f32 toleranceSqr = Tolerance * Tolerance;
+
+    CVector samples[NUM_FALLBACK_SAMPLES + 1];
+    for (u32 i = 0; i <= NUM_FALLBACK_SAMPLES; i++)
+    {
+        samples[i] = blend.Position(static_cast<f32>(i) / static_cast<f32>(NUM_FALLBACK_SAMPLES));
+    }
+
+    CSpan stack[MAX_FALLBACK_DEPTH + 1];
+    u32 numSpans = 0;
+    stack[numSpans++] = {0.0f, 1.0f, samples[0], samples[NUM_FALLBACK_SAMPLES], 0, NUM_FALLBACK_SAMPLES, 0};
+
+    writer.Add(0.0f, samples[0]);
+    while (numSpans > 0)
+    {
+        const CSpan span = stack[--numSpans];
+        const f32 midTime = (span.StartTime + span.EndTime) * 0.5f;
+        const u32 half = span.NumSamples / 2;
+
+        CVector mid;
+        bool bFlat = true;
+        if (span.NumSamples > 1)
+        {
+            mid = samples[span.FirstSample + half];
+            for (u32 i = 1; i < span.NumSamples && bFlat; i++)
+            {
+                bFlat = DistSqrToChord(span.Start, span.End, samples[span.FirstSample + i]) <= toleranceSqr;
+            }
+        }
+        else
+        {
+            mid = blend.Position(midTime);
+            bFlat = DistSqrToChord(span.Start, span.End, mid) <= toleranceSqr;
+        }
+
+        if (!bFlat && span.Depth < MAX_FALLBACK_DEPTH)
+        {
+            stack[numSpans++] = {midTime, span.EndTime, mid, span.End, span.FirstSample + half, half, span.Depth + 1};
+            stack[numSpans++] = {span.StartTime, midTime, span.Start, mid, span.FirstSample, half, span.Depth + 1};
+        }
+        else
+        {
+            writer.Add(span.EndTime, span.End);
+        }
+    }
+}
+
+// Ends of the straights and even steps of the bend, see CCurves::CalcCurvePolyline
+void SampleCrossing(const CCurveSegment& segment, f32 Tolerance, CPolylineWriter& writer)
+{
+    writer.Add(0.0f, segment.StartCoors);
+    if (segment.TotalDist_Time <= 0.0f)
+    {
+        // start and end on the crossing, the whole curve is one point
+        return;
+    }
+
+    const f32 invTotalDist = 1.0f / segment.TotalDist_Time;
+    const CVector bendStart = segment.StartCoors + segment.StartDir * segment.StraightDist1;
+    const CVector bendEnd = segment.EndCoors - segment.EndDir * segment.StraightDist2;
+    const CVector startStep = segment.StartDir * segment.BendDistOneSegment;
+    const CVector endStep = segment.EndDir * segment.BendDistOneSegment;
+
+    if (segment.StraightDist1 > 0.0f)
+    {
+        writer.Add(segment.StraightDist1 * invTotalDist, bendStart);
+    }
+
+    // The bend is bendStart + L * t - K * t^2 with K = startStep - endStep, a chord over a step h misses it by at
+    // most |K| * h^2 / 4 (halfway along the step), so steps of 2 * sqrt(Tolerance / |K|) are the longest that fit
+    const CVector K = startStep - endStep;
+    const f32 curvature = CMaths::Sqrt(Dot(K, K));
+    const f32 maxSteps = static_cast<f32>(MAX_BEND_STEPS);
+    const f32 steps = Tolerance > 0.0f ? std::ceil(0.5f * CMaths::Sqrt(curvature / Tolerance)) : maxSteps;
+    const u32 numSteps = static_cast<u32>(std::clamp(steps, 1.0f, maxSteps));
+
+    const f32 stepInter = 1.0f / static_cast<f32>(numSteps);
+    for (u32 i = 1; i < numSteps; i++)
+    {
+        const f32 BendInter = static_cast<f32>(i) * stepInter;
+        const f32 oneMinusBendInter = 1.0f - BendInter;
+        const CVector startInfluence = bendStart + startStep * BendInter;
+        const CVector endInfluence = bendEnd - endStep * oneMinusBendInter;
+        writer.Add((segment.StraightDist1 + segment.BendDist * BendInter) * invTotalDist,
+            startInfluence * oneMinusBendInter + endInfluence * BendInter);
+    }
+
+    if (segment.StraightDist2 > 0.0f)
+    {
+        // the second straight starts at EndCoors, a chord joins it to the end of the bend
+        const f32 secondStraightTime = segment.GetSecondStraightTime();
+        writer.Add(std::nextafter(secondStraightTime, 0.0f), bendEnd);
+        writer.Add(secondStraightTime, segment.EndCoors);
+        writer.Add(1.0f, segment.EndCoors + segment.EndDir * segment.StraightDist2);
+    }
+    else
+    {
+        writer.Add(1.0f, segment.EndCoors);
+    }
+}
+}  // namespace
+
+u32 CCurves::CalcCurvePolyline(
+    const CCurveSegment& segment, f32 Tolerance, CVector* pPoints, f32* pTimes, u32 MaxPoints)
+{
+    CPolylineWriter writer(pPoints, pTimes, MaxPoints);
+    if (segment.bCrossing)
+    {
+        SampleCrossing(segment, Tolerance, writer);
+    }
+    else
+    {
+        SampleFallback(segment, Tolerance, writer);
+    }
+    return writer.GetNumPoints();
+}
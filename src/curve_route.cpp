@@ -0,0 +1,122 @@
+#include <algorithm>
+
+#include "curve_route.hpp"
+#include "maths.hpp"
+
+void CCurveRoute::PushBack(const CCurveSegment& segment, i32 TraverselTimeInMillis)
+{
+    f64 startDist = 0.0;
+    f64 startTime = 0.0;
+    if (!m_Links.empty())
+    {
+        const CLink& last = m_Links.back();
+        startDist = last.StartDist + last.Length;
+        startTime = last.StartTime + last.TraverselTimeInMillis;
+    }
+
+    m_Links.push_back(
+        {segment, TraverselTimeInMillis, CCurves::CalcSpeedScaleFactor(segment), startDist, startTime});
+}
+
+void CCurveRoute::PushFront(const CCurveSegment& segment, i32 TraverselTimeInMillis)
+{
+    const f32 length = CCurves::CalcSpeedScaleFactor(segment);
+
+    f64 startDist = 0.0;
+    f64 startTime = 0.0;
+    if (!m_Links.empty())
+    {
+        const CLink& first = m_Links.front();
+        startDist = first.StartDist - length;
+        startTime = first.StartTime - TraverselTimeInMillis;
+    }
+
+    m_Links.push_front({segment, TraverselTimeInMillis, length, startDist, startTime});
+}
+
+void CCurveRoute::PopBack()
+{
+    m_Links.pop_back();
+}
+
+void CCurveRoute::PopFront()
+{
+    m_Links.pop_front();
+}
+
+f32 CCurveRoute::GetCurveStartDist(u32 Index) const
+{
+    return static_cast<f32>(m_Links[Index].StartDist - m_Links.front().StartDist);
+}
+
+f32 CCurveRoute::GetLength() const
+{
+    if (m_Links.empty())
+    {
+        return 0.0f;
+    }
+    return static_cast<f32>(m_Links.back().StartDist + m_Links.back().Length - m_Links.front().StartDist);
+}
+
+f32 CCurveRoute::GetTraverselTimeInMillis() const
+{
+    if (m_Links.empty())
+    {
+        return 0.0f;
+    }
+    return static_cast<f32>(
+        m_Links.back().StartTime + m_Links.back().TraverselTimeInMillis - m_Links.front().StartTime);
+}
+
+u32 CCurveRoute::FindCurveAtDist(f32 Dist, f32* pTime) const
+{
+    const f64 target = VCLAMP(m_Links.front().StartDist, m_Links.back().StartDist + m_Links.back().Length,
+        m_Links.front().StartDist + Dist);
+
+    // last curve starting at or before the target, the first one if the target is on its start
+    const auto it = std::upper_bound(m_Links.begin() + 1, m_Links.end(), target,
+                        [](f64 Value, const CLink& link) { return Value < link.StartDist; }) -
+                    1;
+
+    if (pTime)
+    {
+        *pTime = it->Length > 0.0f ? VCLAMP(0.0f, 1.0f, static_cast<f32>((target - it->StartDist) / it->Length)) : 0.0f;
+    }
+    return static_cast<u32>(it - m_Links.begin());
+}
+
+u32 CCurveRoute::FindCurveAtTime(f32 TimeInMillis, f32* pTime) const
+{
+    const f64 target = VCLAMP(m_Links.front().StartTime, m_Links.back().StartTime + m_Links.back().TraverselTimeInMillis,
+        m_Links.front().StartTime + TimeInMillis);
+
+    const auto it = std::upper_bound(m_Links.begin() + 1, m_Links.end(), target,
+                        [](f64 Value, const CLink& link) { return Value < link.StartTime; }) -
+                    1;
+
+    if (pTime)
+    {
+        *pTime = it->TraverselTimeInMillis > 0
+                     ? VCLAMP(0.0f, 1.0f, static_cast<f32>((target - it->StartTime) / it->TraverselTimeInMillis))
+                     : 0.0f;
+    }
+    return static_cast<u32>(it - m_Links.begin());
+}
+
+u32 CCurveRoute::CalcPointAtDist(f32 Dist, CVector& resultCoor, CVector& resultSpeed) const
+{
+    f32 Time;
+    const u32 index = FindCurveAtDist(Dist, &Time);
+    const CLink& link = m_Links[index];
+    CCurves::CalcCurvePoint(link.Segment, Time, link.TraverselTimeInMillis, resultCoor, resultSpeed);
+    return index;
+}
+
+u32 CCurveRoute::CalcPointAtTime(f32 TimeInMillis, CVector& resultCoor, CVector& resultSpeed) const
+{
+    f32 Time;
+    const u32 index = FindCurveAtTime(TimeInMillis, &Time);
+    const CLink& link = m_Links[index];
+    CCurves::CalcCurvePoint(link.Segment, Time, link.TraverselTimeInMillis, resultCoor, resultSpeed);
+    return index;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <deque>
+
+#include "curves.hpp"
+
+/// A chain of consecutive curves, evaluated at a distance or time measured from the start of the whole route.
+///
+/// Keeps running totals of the curve lengths (by the rules of `CCurves::CalcSpeedScaleFactor`) and traversal times,
+/// so finding the curve under a route distance or time is a binary search and the point itself one
+/// `CCurves::CalcCurvePoint`. Curves can be added and dropped at both ends without touching the others, as a
+/// vehicle's lookahead grows in front of it and the links behind it are let go.
+class CCurveRoute
+{
+public:
+    /// Appends a curve after the current last one.
+    /// \param segment The curve, copied into the route.
+    /// \param TraverselTimeInMillis The total traversal time in milliseconds for the curve.
+    void PushBack(const CCurveSegment& segment, i32 TraverselTimeInMillis);
+
+    /// Inserts a curve before the current first one, which shifts every route distance and time by its length and
+    /// traversal time.
+    void PushFront(const CCurveSegment& segment, i32 TraverselTimeInMillis);
+
+    void PopBack();
+    void PopFront();
+    void Clear() { m_Links.clear(); }
+
+    bool IsEmpty() const { return m_Links.empty(); }
+    u32 GetNumCurves() const { return static_cast<u32>(m_Links.size()); }
+    const CCurveSegment& GetCurve(u32 Index) const { return m_Links[Index].Segment; }
+
+    /// Distance along the curve `Index` starts at, from the start of the route.
+    f32 GetCurveStartDist(u32 Index) const;
+
+    /// Sum of the curve lengths.
+    f32 GetLength() const;
+
+    /// Sum of the curve traversal times.
+    f32 GetTraverselTimeInMillis() const;
+
+    /// Finds the curve under a distance along the route.
+    /// \param Dist Distance from the start of the route, clamped to the route.
+    /// \param pTime Receives the time on that curve, normalized between 0.0 and 1.0. May be null.
+    /// \return The index of the curve. The route must not be empty.
+    u32 FindCurveAtDist(f32 Dist, f32* pTime = nullptr) const;
+
+    /// Finds the curve under a time since the start of the route, see `FindCurveAtDist`.
+    u32 FindCurveAtTime(f32 TimeInMillis, f32* pTime = nullptr) const;
+
+    /// Calculates the point and speed at a distance along the route, as `CCurves::CalcCurvePoint` on the curve
+    /// found by `FindCurveAtDist`.
+    /// \return The index of the curve the point is on.
+    u32 CalcPointAtDist(f32 Dist, CVector& resultCoor, CVector& resultSpeed) const;
+
+    /// Calculates the point and speed at a time since the start of the route, see `CalcPointAtDist`.
+    u32 CalcPointAtTime(f32 TimeInMillis, CVector& resultCoor, CVector& resultSpeed) const;
+
+private:
+    // StartDist and StartTime are counted from wherever the first curve ever pushed started, curves pushed in front
+    // of it go negative. Doubles, so a route that keeps sliding forward doesn't lose precision over a session.
+    struct CLink
+    {
+        CCurveSegment Segment;
+        i32 TraverselTimeInMillis;
+        f32 Length;
+        f64 StartDist;
+        f64 StartTime;
+    };
+
+    std::deque<CLink> m_Links;
+};
@@ -0,0 +1,158 @@
+#include <cmath>
+
+#include "curve_stats.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+
+CCurveSegment::CCurveSegment(
+    const CVector& startCoors, const CVector& endCoors, const CVector& startDir, const CVector& endDir)
+    : StartCoors(startCoors), EndCoors(endCoors), StartDir(startDir), EndDir(endDir)
+{
+    SpeedVariation =
+        CCurves::CalcSpeedVariationInBend(startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+
+    DistToPoint1 = CCurves::DistForLineToCrossOtherLine(
+        startCoors.x, startCoors.y, startDir.x, startDir.y, endCoors.x, endCoors.y, endDir.x, endDir.y);
+    DistToPoint2 = -CCurves::DistForLineToCrossOtherLine(
+        endCoors.x, endCoors.y, endDir.x, endDir.y, startCoors.x, startCoors.y, startDir.x, startDir.y);
+
+    const f32 dx = startCoors.x - endCoors.x;
+    const f32 dy = startCoors.y - endCoors.y;
+    StraightDist = CMaths::Sqrt(dx * dx + dy * dy);
+
+    bCrossing = !(DistToPoint1 <= 0.0f || DistToPoint2 <= 0.0f);
+
+    if (!bCrossing)
+    {
+        BendDistOneSegment = 0.0f;
+        StraightDist1 = 0.0f;
+        StraightDist2 = 0.0f;
+        BendDist = StraightDist / (1.0f - SpeedVariation);
+        TotalDist_Time = 0.0f;
+        return;
+    }
+
+    BendDistOneSegment = CMaths::Min(CMaths::Min(DistToPoint1, DistToPoint2), 5.0f);
+    StraightDist1 = DistToPoint1 - BendDistOneSegment;
+    StraightDist2 = DistToPoint2 - BendDistOneSegment;
+    BendDist = BendDistOneSegment * 2.0f;
+    TotalDist_Time = StraightDist1 + BendDist + StraightDist2;
+}
+
+f32 CCurveSegment::GetSecondStraightTime() const
+{
+    const f32 bendEndDist = StraightDist1 + BendDist;
+    if (!bCrossing || !(TotalDist_Time > bendEndDist))
+    {
+        return 1.0f;
+    }
+
+    // the division can round either way, step to the first Time past the bend by CalcCurvePoint's own compare
+    f32 Time = bendEndDist / TotalDist_Time;
+    while (!(TotalDist_Time * Time > bendEndDist))
+    {
+        Time = std::nextafter(Time, 2.0f);
+    }
+    return Time;
+}
+
+void CCurves::CalcCurvePoint(
+    const CCurveSegment& segment, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed)
+{
+    const CVector& startCoors = segment.StartCoors;
+    const CVector& endCoors = segment.EndCoors;
+    const CVector& startDir = segment.StartDir;
+    const CVector& endDir = segment.EndDir;
+
+    const f32 OurTime = VCLAMP(0.0f, 1.0f, Time);
+
+    CURVE_STAT_RECORD(HISTOGRAM_CURVE_POINT_TIME, Time);
+    CURVE_STAT_RECORD(HISTOGRAM_STRAIGHT_DIST, segment.StraightDist);
+    if (OurTime != Time)
+    {
+        CURVE_STAT_COUNT(CURVE_POINT_TIME_CLAMPED);
+    }
+
+    if (!segment.bCrossing)
+    {
+        CURVE_STAT_COUNT(CURVE_POINT_FALLBACK);
+
+        // Blend between the positions projected along both rays
+        f32 Interpol;
+        const f32 CurrentDist_Time =
+            CalcCorrectedDist(segment.BendDist * OurTime, segment.BendDist, segment.SpeedVariation, &Interpol);
+        const f32 distDiff = CurrentDist_Time - segment.StraightDist;
+        const f32 oneMinusInterpol = 1.0f - Interpol;
+
+        resultCoor.x = (startCoors.x + startDir.x * CurrentDist_Time) * oneMinusInterpol +
+                       (endCoors.x + endDir.x * distDiff) * Interpol;
+        resultCoor.y = (startCoors.y + startDir.y * CurrentDist_Time) * oneMinusInterpol +
+                       (endCoors.y + endDir.y * distDiff) * Interpol;
+        resultCoor.z = (startCoors.z + startDir.z * CurrentDist_Time) * oneMinusInterpol +
+                       (endCoors.z + endDir.z * distDiff) * Interpol;
+    }
+    else
+    {
+        const f32 distanceAtTime = segment.TotalDist_Time * OurTime;
+
+        if (distanceAtTime < segment.StraightDist1)
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_FIRST_STRAIGHT);
+
+            resultCoor.x = startCoors.x + startDir.x * distanceAtTime;
+            resultCoor.y = startCoors.y + startDir.y * distanceAtTime;
+            resultCoor.z = startCoors.z + startDir.z * distanceAtTime;
+        }
+        else if (distanceAtTime > (segment.StraightDist1 + segment.BendDist))
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_SECOND_STRAIGHT);
+
+            const f32 secondSegmentDist = distanceAtTime - (segment.StraightDist1 + segment.BendDist);
+            resultCoor.x = endCoors.x + endDir.x * secondSegmentDist;
+            resultCoor.y = endCoors.y + endDir.y * secondSegmentDist;
+            resultCoor.z = endCoors.z + endDir.z * secondSegmentDist;
+        }
+        else
+        {
+            CURVE_STAT_COUNT(CURVE_POINT_BEND);
+
+            const f32 BendInter = (distanceAtTime - segment.StraightDist1) / segment.BendDist;
+            const f32 oneMinusBendInter = 1.0f - BendInter;
+
+            // Distances of the influence points along the start ray and back along the end ray
+            const f32 startInfluence = segment.StraightDist1 + segment.BendDistOneSegment * BendInter;
+            const f32 endInfluence = segment.StraightDist2 + segment.BendDistOneSegment * oneMinusBendInter;
+
+            resultCoor.x = (startCoors.x + startDir.x * startInfluence) * oneMinusBendInter +
+                           (endCoors.x - endDir.x * endInfluence) * BendInter;
+            resultCoor.y = (startCoors.y + startDir.y * startInfluence) * oneMinusBendInter +
+                           (endCoors.y - endDir.y * endInfluence) * BendInter;
+            resultCoor.z = (startCoors.z + startDir.z * startInfluence) * oneMinusBendInter +
+                           (endCoors.z - endDir.z * endInfluence) * BendInter;
+        }
+    }
+
+    const f32 timeScale = static_cast<f32>(TraverselTimeInMillis) * 0.001f;
+    const f32 t1 = 1.0f - OurTime;
+    const f32 speed = segment.TotalDist_Time / timeScale;
+
+    resultSpeed.x = (endDir.x * OurTime + startDir.x * t1) * speed;
+    resultSpeed.y = (endDir.y * OurTime + startDir.y * t1) * speed;
+    resultSpeed.z = 0.0f;
+}
+
+f32 CCurves::CalcSpeedScaleFactor(const CCurveSegment& segment)
+{
+    return segment.bCrossing ? segment.TotalDist_Time : segment.BendDist;
+}
+
+void CCurves::CalcCurveState(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+    const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CCurveState& result)
+{
+    const CCurveSegment segment(startCoors, endCoors, startDir, endDir);
+
+    CalcCurvePoint(segment, Time, TraverselTimeInMillis, result.Coors, result.Speed);
+    result.TotalDist = segment.TotalDist_Time;
+    result.SpeedVariation = segment.SpeedVariation;
+    result.SpeedScaleFactor = CalcSpeedScaleFactor(segment);
+}
@@ -0,0 +1,288 @@
+#include "curve_stats.hpp"
+
+#ifdef CURVES_STATS
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// One thread's counts. Only the owner writes, with a relaxed load and store instead of a locked add; the atomics are
+// there so GetSnapshot and Reset can read and zero them from other threads.
+struct alignas(64) CThreadBlock
+{
+    std::atomic<u64> Counters[CCurveStats::NUM_COUNTERS];
+    std::atomic<u64> Histograms[CCurveStats::NUM_HISTOGRAMS][CCurveStats::NUM_BUCKETS + 2];
+};
+
+void Bump(std::atomic<u64>& value, u64 Amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+}
+
+// every live thread's block, and the sums of the threads that have exited
+struct CRegistry
+{
+    std::mutex Mutex;
+    std::vector<CThreadBlock*> Blocks;
+    CCurveStats::CSnapshot Retired = {};
+};
+
+CRegistry& GetRegistry()
+{
+    // never destroyed, threads can still exit while static destructors run
+    static CRegistry* pRegistry = new CRegistry;
+    return *pRegistry;
+}
+
+void AddBlock(CCurveStats::CSnapshot& sum, const CThreadBlock& block)
+{
+    for (u32 i = 0; i < CCurveStats::NUM_COUNTERS; i++)
+    {
+        sum.Counters[i] += block.Counters[i].load(std::memory_order_relaxed);
+    }
+    for (u32 h = 0; h < CCurveStats::NUM_HISTOGRAMS; h++)
+    {
+        for (u32 b = 0; b < CCurveStats::NUM_BUCKETS + 2; b++)
+        {
+            sum.Histograms[h][b] += block.Histograms[h][b].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Registers the thread's block on its first count and folds it into the retired sums when the thread exits
+struct CThreadBlockOwner
+{
+    CThreadBlock Block = {};
+
+    CThreadBlockOwner()
+    {
+        CRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+        registry.Blocks.push_back(&Block);
+    }
+
+    ~CThreadBlockOwner()
+    {
+        CRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+        AddBlock(registry.Retired, Block);
+        std::erase(registry.Blocks, &Block);
+    }
+};
+
+CThreadBlock& GetThreadBlock()
+{
+    thread_local CThreadBlockOwner owner;
+    return owner.Block;
+}
+
+constexpr const char* COUNTER_NAMES[CCurveStats::NUM_COUNTERS] = {
+    "DistForLineToCrossOtherLine calls",
+    "DistForLineToCrossOtherLine parallel",
+    "CalcSpeedVariationInBend dot <= 0",
+    "CalcSpeedVariationInBend dot <= 0.7",
+    "CalcSpeedVariationInBend dot > 0.7",
+    "CalcSpeedScaleFactor crossing",
+    "CalcSpeedScaleFactor fallback",
+    "CalcCorrectedDist calls",
+    "CalcCorrectedDist zero total",
+    "CalcCurvePoint fallback",
+    "CalcCurvePoint first straight",
+    "CalcCurvePoint bend",
+    "CalcCurvePoint second straight",
+    "CalcCurvePoint Time clamped",
+    "CalcCurvePoints curves",
+};
+
+// the counter every other one in its group is a share of, itself if it is a group of its own
+constexpr CCurveStats::eCounter COUNTER_TOTALS[CCurveStats::NUM_COUNTERS] = {
+    CCurveStats::DIST_FOR_LINE_CALLS,
+    CCurveStats::DIST_FOR_LINE_CALLS,
+    CCurveStats::SPEED_VARIATION_DOT_BELOW_ZERO,
+    CCurveStats::SPEED_VARIATION_DOT_BELOW_ZERO,
+    CCurveStats::SPEED_VARIATION_DOT_BELOW_ZERO,
+    CCurveStats::SCALE_FACTOR_CROSSING,
+    CCurveStats::SCALE_FACTOR_CROSSING,
+    CCurveStats::CORRECTED_DIST_CALLS,
+    CCurveStats::CORRECTED_DIST_CALLS,
+    CCurveStats::CURVE_POINT_FALLBACK,
+    CCurveStats::CURVE_POINT_FALLBACK,
+    CCurveStats::CURVE_POINT_FALLBACK,
+    CCurveStats::CURVE_POINT_FALLBACK,
+    CCurveStats::CURVE_POINT_FALLBACK,
+    CCurveStats::CURVE_POINTS_BATCHED,
+};
+
+// groups whose branch counters add up to their total instead of having a calls counter
+bool IsBranchGroup(CCurveStats::eCounter Total)
+{
+    return Total == CCurveStats::SPEED_VARIATION_DOT_BELOW_ZERO || Total == CCurveStats::SCALE_FACTOR_CROSSING ||
+           Total == CCurveStats::CURVE_POINT_FALLBACK;
+}
+
+u64 GetGroupTotal(const CCurveStats::CSnapshot& snapshot, CCurveStats::eCounter Total)
+{
+    if (!IsBranchGroup(Total))
+    {
+        return snapshot.Counters[Total];
+    }
+
+    u64 total = 0;
+    for (u32 i = 0; i < CCurveStats::NUM_COUNTERS; i++)
+    {
+        // the Time clamped count overlaps the four sections
+        if (COUNTER_TOTALS[i] == Total && i != CCurveStats::CURVE_POINT_TIME_CLAMPED)
+        {
+            total += snapshot.Counters[i];
+        }
+    }
+    return total;
+}
+
+struct CHistogramInfo
+{
+    const char* Name;
+    f32 Min;
+    f32 Max;
+};
+
+constexpr CHistogramInfo HISTOGRAMS[CCurveStats::NUM_HISTOGRAMS] = {
+    {"CalcCurvePoint Time", 0.0f, 1.0f},
+    {"CalcSpeedVariationInBend dot product", -1.0f, 1.0f},
+    {"CalcCurvePoint start to end distance", 0.0f, 160.0f},
+};
+}  // namespace
+
+void CCurveStats::Count(eCounter Counter, u64 Amount)
+{
+    Bump(GetThreadBlock().Counters[Counter], Amount);
+}
+
+void CCurveStats::Record(eHistogram Histogram, f32 Value)
+{
+    const CHistogramInfo& info = HISTOGRAMS[Histogram];
+
+    // NaN lands above the range
+    u32 bucket = NUM_BUCKETS + 1;
+    if (Value < info.Min)
+    {
+        bucket = 0;
+    }
+    else if (Value <= info.Max)
+    {
+        const f32 pos = (Value - info.Min) / (info.Max - info.Min) * static_cast<f32>(NUM_BUCKETS);
+        bucket = 1 + (pos >= static_cast<f32>(NUM_BUCKETS) ? NUM_BUCKETS - 1 : static_cast<u32>(pos));
+    }
+
+    Bump(GetThreadBlock().Histograms[Histogram][bucket], 1);
+}
+
+CCurveStats::CSnapshot CCurveStats::GetSnapshot()
+{
+    CRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    CSnapshot sum = registry.Retired;
+    for (const CThreadBlock* pBlock : registry.Blocks)
+    {
+        AddBlock(sum, *pBlock);
+    }
+    return sum;
+}
+
+void CCurveStats::Reset()
+{
+    CRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    registry.Retired = {};
+    for (CThreadBlock* pBlock : registry.Blocks)
+    {
+        for (std::atomic<u64>& counter : pBlock->Counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& histogram : pBlock->Histograms)
+        {
+            for (std::atomic<u64>& bucket : histogram)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void CCurveStats::Dump(FILE* pFile)
+{
+    const CSnapshot snapshot = GetSnapshot();
+
+    std::fprintf(pFile, "%-40s %14s %8s\n", "counter", "count", "share");
+    for (u32 i = 0; i < NUM_COUNTERS; i++)
+    {
+        const u64 total = GetGroupTotal(snapshot, COUNTER_TOTALS[i]);
+        const f64 share = total ? 100.0 * static_cast<f64>(snapshot.Counters[i]) / static_cast<f64>(total) : 0.0;
+        std::fprintf(pFile, "%-40s %14llu %7.2f%%\n", COUNTER_NAMES[i],
+            static_cast<unsigned long long>(snapshot.Counters[i]), share);
+    }
+
+    for (u32 h = 0; h < NUM_HISTOGRAMS; h++)
+    {
+        const CHistogramInfo& info = HISTOGRAMS[h];
+        const u64* pBuckets = snapshot.Histograms[h];
+
+        u64 most = 1;
+        for (u32 b = 0; b < NUM_BUCKETS + 2; b++)
+        {
+            most = pBuckets[b] > most ? pBuckets[b] : most;
+        }
+
+        std::fprintf(pFile, "\n%s\n", info.Name);
+        const f32 step = (info.Max - info.Min) / static_cast<f32>(NUM_BUCKETS);
+        for (u32 b = 0; b < NUM_BUCKETS + 2; b++)
+        {
+            char range[48];
+            if (b == 0)
+            {
+                std::snprintf(range, sizeof(range), "< %g", info.Min);
+            }
+            else if (b == NUM_BUCKETS + 1)
+            {
+                std::snprintf(range, sizeof(range), "> %g", info.Max);
+            }
+            else
+            {
+                std::snprintf(range, sizeof(range), "%g .. %g", info.Min + step * static_cast<f32>(b - 1),
+                    info.Min + step * static_cast<f32>(b));
+            }
+
+            char bar[41] = {};
+            const u32 length = static_cast<u32>(40 * pBuckets[b] / most);
+            for (u32 c = 0; c < length; c++)
+            {
+                bar[c] = '#';
+            }
+            std::fprintf(pFile, "  %-20s %14llu%s%s\n", range, static_cast<unsigned long long>(pBuckets[b]),
+                length ? " " : "", bar);
+        }
+    }
+}
+
+const char* CCurveStats::GetCounterName(eCounter Counter)
+{
+    return COUNTER_NAMES[Counter];
+}
+
+const char* CCurveStats::GetHistogramName(eHistogram Histogram)
+{
+    return HISTOGRAMS[Histogram].Name;
+}
+
+void CCurveStats::GetHistogramRange(eHistogram Histogram, f32& Min, f32& Max)
+{
+    Min = HISTOGRAMS[Histogram].Min;
+    Max = HISTOGRAMS[Histogram].Max;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "curves.hpp"
+
+/// Counts of the branches the curve functions take and histograms of their inputs, for finding out what the real
+/// workload looks like before optimizing for it.
+///
+/// Only built with `CURVES_STATS` defined (the xmake `stats` option). Without it the `CURVE_STAT_*` macros the curve
+/// functions are instrumented with expand to nothing and none of this exists. With it, every thread counts into its
+/// own block, so the hot paths never share a cache line or take a lock; `GetSnapshot` sums all of them, threads that
+/// have exited included. Counts include the calls the curve functions make to each other, `CalcCurvePoint` on four
+/// vectors also counts a `CalcSpeedVariationInBend` and two `DistForLineToCrossOtherLine`.
+#ifdef CURVES_STATS
+
+#include <cstdio>
+
+class CCurveStats
+{
+public:
+    enum eCounter : u32
+    {
+        DIST_FOR_LINE_CALLS,
+        DIST_FOR_LINE_PARALLEL,
+        SPEED_VARIATION_DOT_BELOW_ZERO,
+        SPEED_VARIATION_DOT_BELOW_0_7,
+        SPEED_VARIATION_DOT_ABOVE_0_7,
+        SCALE_FACTOR_CROSSING,
+        SCALE_FACTOR_FALLBACK,
+        CORRECTED_DIST_CALLS,
+        CORRECTED_DIST_ZERO_TOTAL,
+        CURVE_POINT_FALLBACK,
+        CURVE_POINT_FIRST_STRAIGHT,
+        CURVE_POINT_BEND,
+        CURVE_POINT_SECOND_STRAIGHT,
+        CURVE_POINT_TIME_CLAMPED,
+        CURVE_POINTS_BATCHED,
+        NUM_COUNTERS
+    };
+
+    enum eHistogram : u32
+    {
+        HISTOGRAM_CURVE_POINT_TIME,  // Time passed to CalcCurvePoint, [0, 1]
+        HISTOGRAM_DOT_PRODUCT,       // start and end direction dot product in CalcSpeedVariationInBend, [-1, 1]
+        HISTOGRAM_STRAIGHT_DIST,     // start to end distance of the curves CalcCurvePoint evaluates, [0, 160]
+        NUM_HISTOGRAMS
+    };
+
+    /// Buckets evenly spread over the histogram's range, plus one below and one above it.
+    static constexpr u32 NUM_BUCKETS = 16;
+
+    struct CSnapshot
+    {
+        u64 Counters[NUM_COUNTERS];
+        u64 Histograms[NUM_HISTOGRAMS][NUM_BUCKETS + 2];  // [0] below the range, [NUM_BUCKETS + 1] above it
+    };
+
+    static void Count(eCounter Counter, u64 Amount = 1);
+    static void Record(eHistogram Histogram, f32 Value);
+
+    /// Sums the blocks of every thread. Counts made while this runs may or may not be in it.
+    static CSnapshot GetSnapshot();
+
+    /// Zeroes every block. Not exact while other threads are counting, their in-flight updates can survive it.
+    static void Reset();
+
+    /// Writes a snapshot as text, counters with their share of their group and histograms as bars.
+    static void Dump(FILE* pFile);
+
+    static const char* GetCounterName(eCounter Counter);
+    static const char* GetHistogramName(eHistogram Histogram);
+
+    /// Lower and upper end of a histogram's range.
+    static void GetHistogramRange(eHistogram Histogram, f32& Min, f32& Max);
+};
+
+// usable inside the constexpr curve math, constant evaluation doesn't count
+#define CURVE_STAT_COUNT(counter)                                                                                     \
+    do                                                                                                                \
+    {                                                                                                                 \
+        if !consteval                                                                                                 \
+        {                                                                                                             \
+            CCurveStats::Count(CCurveStats::counter);                                                                 \
+        }                                                                                                             \
+    } while (0)
+#define CURVE_STAT_ADD(counter, amount)                                                                               \
+    do                                                                                                                \
+    {                                                                                                                 \
+        if !consteval                                                                                                 \
+        {                                                                                                             \
+            CCurveStats::Count(CCurveStats::counter, amount);                                                         \
+        }                                                                                                             \
+    } while (0)
+#define CURVE_STAT_RECORD(histogram, value)                                                                           \
+    do                                                                                                                \
+    {                                                                                                                 \
+        if !consteval                                                                                                 \
+        {                                                                                                             \
+            CCurveStats::Record(CCurveStats::histogram, value);                                                       \
+        }                                                                                                             \
+    } while (0)
+
+#else
+
+#define CURVE_STAT_COUNT(counter) ((void)0)
+#define CURVE_STAT_ADD(counter, amount) ((void)0)
+#define CURVE_STAT_RECORD(histogram, value) ((void)0)
+
+#endif
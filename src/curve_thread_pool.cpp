@@ -0,0 +1,217 @@
+#include "curve_thread_pool.hpp"
+
+namespace
+{
+constexpr u64 PackRange(u32 Begin, u32 End)
+{
+    return static_cast<u64>(Begin) | (static_cast<u64>(End) << 32);
+}
+
+constexpr u32 RangeBegin(u64 Range)
+{
+    return static_cast<u32>(Range);
+}
+
+constexpr u32 RangeEnd(u64 Range)
+{
+    return static_cast<u32>(Range >> 32);
+}
+
+struct CCurvePointsJob
+{
+    const CCurveBatch* pCurves;
+    const CCurveBatchResult* pResult;
+    u32 Count;
+};
+
+void CalcCurvePointsChunk(void* pContext, u32 Chunk)
+{
+    const CCurvePointsJob& job = *static_cast<const CCurvePointsJob*>(pContext);
+    const CCurveBatch& in = *job.pCurves;
+    const CCurveBatchResult& out = *job.pResult;
+
+    const u32 first = Chunk * CCurveThreadPool::CURVES_PER_CHUNK;
+    const u32 count = job.Count - first < CCurveThreadPool::CURVES_PER_CHUNK ? job.Count - first
+                                                                            : CCurveThreadPool::CURVES_PER_CHUNK;
+
+    const CCurveBatch curves = {in.StartX + first, in.StartY + first, in.StartZ + first, in.EndX + first,
+        in.EndY + first, in.EndZ + first, in.StartDirX + first, in.StartDirY + first, in.StartDirZ + first,
+        in.EndDirX + first, in.EndDirY + first, in.EndDirZ + first, in.Time + first, in.TraverselTimeInMillis + first};
+    const CCurveBatchResult result = {out.CoorX + first, out.CoorY + first, out.CoorZ + first, out.SpeedX + first,
+        out.SpeedY + first, out.SpeedZ + first};
+
+    CCurves::CalcCurvePoints(curves, count, result);
+}
+}  // namespace
+
+CCurveThreadPool::CCurveThreadPool(u32 NumThreads)
+    : m_nNumThreads(NumThreads), m_nGeneration(0), m_nNumBusy(0), m_bStop(false), m_pfnChunk(nullptr),
+      m_pContext(nullptr)
+{
+    if (m_nNumThreads == 0)
+    {
+        m_nNumThreads = std::thread::hardware_concurrency();
+    }
+    if (m_nNumThreads == 0)
+    {
+        m_nNumThreads = 1;
+    }
+
+    m_Shares = std::vector<CShare>(m_nNumThreads);
+
+    // slot 0 is the thread calling Run
+    m_Threads.reserve(m_nNumThreads - 1);
+    for (u32 slot = 1; slot < m_nNumThreads; slot++)
+    {
+        m_Threads.emplace_back(&CCurveThreadPool::WorkerThread, this, slot);
+    }
+}
+
+CCurveThreadPool::~CCurveThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bStop = true;
+    }
+    m_StartCondition.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+void CCurveThreadPool::Run(u32 NumChunks, ChunkFn pfnChunk, void* pContext)
+{
+    if (NumChunks == 0)
+    {
+        return;
+    }
+
+    if (m_nNumThreads == 1 || NumChunks == 1)
+    {
+        for (u32 chunk = 0; chunk < NumChunks; chunk++)
+        {
+            pfnChunk(pContext, chunk);
+        }
+        return;
+    }
+
+    // even shares, the first NumChunks % m_nNumThreads threads get one more
+    const u32 perThread = NumChunks / m_nNumThreads;
+    const u32 extra = NumChunks % m_nNumThreads;
+    u32 begin = 0;
+    for (u32 slot = 0; slot < m_nNumThreads; slot++)
+    {
+        const u32 end = begin + perThread + (slot < extra ? 1 : 0);
+        m_Shares[slot].Range.store(PackRange(begin, end), std::memory_order_relaxed);
+        begin = end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_pfnChunk = pfnChunk;
+        m_pContext = pContext;
+        m_nNumBusy = m_nNumThreads - 1;
+        m_nGeneration++;
+    }
+    m_StartCondition.notify_all();
+
+    Work(0);
+
+    // the workers may still be finishing chunks they took, or trying to steal
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this] { return m_nNumBusy == 0; });
+}
+
+void CCurveThreadPool::CalcCurvePoints(const CCurveBatch& curves, u32 Count, const CCurveBatchResult& result)
+{
+    CCurvePointsJob job = {&curves, &result, Count};
+    Run((Count + CURVES_PER_CHUNK - 1) / CURVES_PER_CHUNK, CalcCurvePointsChunk, &job);
+}
+
+void CCurveThreadPool::WorkerThread(u32 Slot)
+{
+    u32 generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_StartCondition.wait(lock, [&] { return m_bStop || m_nGeneration != generation; });
+            if (m_bStop)
+            {
+                return;
+            }
+            generation = m_nGeneration;
+        }
+
+        Work(Slot);
+
+        bool bLast;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            bLast = --m_nNumBusy == 0;
+        }
+        if (bLast)
+        {
+            m_DoneCondition.notify_one();
+        }
+    }
+}
+
+void CCurveThreadPool::Work(u32 Slot)
+{
+    do
+    {
+        u32 chunk;
+        while (PopChunk(Slot, chunk))
+        {
+            m_pfnChunk(m_pContext, chunk);
+        }
+    } while (Steal(Slot));
+}
+
+bool CCurveThreadPool::PopChunk(u32 Slot, u32& Chunk)
+{
+    std::atomic<u64>& share = m_Shares[Slot].Range;
+
+    u64 range = share.load(std::memory_order_acquire);
+    while (RangeBegin(range) < RangeEnd(range))
+    {
+        if (share.compare_exchange_weak(range, PackRange(RangeBegin(range) + 1, RangeEnd(range)),
+                std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            Chunk = RangeBegin(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CCurveThreadPool::Steal(u32 Slot)
+{
+    // Only ever called with an empty own share, so nobody else writes it while we fill it with the stolen chunks.
+    // A thief can't mistake the new range for one it read earlier either: the chunks it read are all taken by now.
+    for (u32 i = 1; i < m_nNumThreads; i++)
+    {
+        std::atomic<u64>& victim = m_Shares[(Slot + i) % m_nNumThreads].Range;
+
+        u64 range = victim.load(std::memory_order_acquire);
+        while (RangeBegin(range) < RangeEnd(range))
+        {
+            // take the back half, rounded up so a single remaining chunk can be stolen too
+            const u32 begin = RangeBegin(range);
+            const u32 end = RangeEnd(range);
+            const u32 mid = begin + (end - begin) / 2;
+
+            if (victim.compare_exchange_weak(
+                    range, PackRange(begin, mid), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                m_Shares[Slot].Range.store(PackRange(mid, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "curves.hpp"
+
+/// Fixed set of worker threads splitting big curve batches between them, with work stealing.
+///
+/// Every run cuts the work into chunks and hands each thread (the calling one included) an even share of the chunk
+/// indices. A thread takes chunks off the front of its own share, and once that is empty steals the back half of
+/// another thread's share, so uneven chunks (fallback curves, a descheduled worker) still balance out. Shares are a
+/// single atomic word per thread, nothing is allocated per run.
+///
+/// Runs are not reentrant, only one thread may call `Run` / `CalcCurvePoints` on a pool at a time.
+class CCurveThreadPool
+{
+public:
+    /// Curves per chunk of `CalcCurvePoints`. A multiple of 16 curves, so with 64-byte aligned arrays two threads
+    /// never write to the same cache line, and a multiple of the SIMD width so only the last chunk has a scalar tail.
+    static constexpr u32 CURVES_PER_CHUNK = 256;
+
+    using ChunkFn = void (*)(void* pContext, u32 Chunk);
+
+    /// \param NumThreads Total threads working on a run, the calling one included. 0 uses every hardware thread.
+    explicit CCurveThreadPool(u32 NumThreads = 0);
+    ~CCurveThreadPool();
+
+    CCurveThreadPool(const CCurveThreadPool&) = delete;
+    CCurveThreadPool& operator=(const CCurveThreadPool&) = delete;
+
+    /// Calls `pfnChunk(pContext, Chunk)` once for every chunk in [0, NumChunks), spread across the threads.
+    /// Returns once all of them have finished.
+    void Run(u32 NumChunks, ChunkFn pfnChunk, void* pContext);
+
+    /// Parallel version of `CCurves::CalcCurvePoints`, same arguments and results.
+    void CalcCurvePoints(const CCurveBatch& curves, u32 Count, const CCurveBatchResult& result);
+
+    u32 GetNumThreads() const { return m_nNumThreads; }
+
+private:
+    // chunk indices [begin, end) still owned by a thread, begin in the low and end in the high 32 bits
+    struct alignas(64) CShare
+    {
+        std::atomic<u64> Range;
+    };
+
+    void WorkerThread(u32 Slot);
+    void Work(u32 Slot);
+    bool PopChunk(u32 Slot, u32& Chunk);
+    bool Steal(u32 Slot);
+
+    u32 m_nNumThreads;
+    std::vector<CShare> m_Shares;
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_StartCondition;
+    std::condition_variable m_DoneCondition;
+    u32 m_nGeneration;  // bumped for every run, wakes the workers
+    u32 m_nNumBusy;     // workers still inside the current run
+    bool m_bStop;
+
+    ChunkFn m_pfnChunk;
+    void* m_pContext;
+};
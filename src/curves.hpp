@@ -1,28 +1,117 @@
+#pragma once
+
+#include <cmath>
+
 // from types.hpp
 using f32 = float;
+using f64 = double;
+using i16 = short;
+using u16 = unsigned short;
 using i32 = int;
 using u32 = unsigned int;
+using i64 = long long;
+using u64 = unsigned long long;
 
+#ifdef _WIN32
 template <u32 addr, typename Ret = void, typename... Args>
 inline Ret Call(Args... a)
 {
     return reinterpret_cast<Ret(__cdecl*)(Args...)>(addr)(a...);
 }
+#endif
 
 // minimal vector class, no need to bring the whole thing over here
 struct CVector
 {
     f32 x, y, z;
 
-    CVector() {}
-    CVector(f32 _x, f32 _y, f32 _z) : x(_x), y(_y), z(_z) {}
+    constexpr CVector() {}
+    constexpr CVector(f32 _x, f32 _y, f32 _z) : x(_x), y(_y), z(_z) {}
+
+    f32 Magnitude() const { return std::sqrt(x * x + y * y + z * z); }
+    f32 Magnitude2D() const { return std::sqrt(x * x + y * y); }
+
+    constexpr CVector operator+(const CVector& o) const { return CVector(x + o.x, y + o.y, z + o.z); }
+    constexpr CVector operator-(const CVector& o) const { return CVector(x - o.x, y - o.y, z - o.z); }
+    constexpr CVector operator*(f32 s) const { return CVector(x * s, y * s, z * s); }
+};
+
+/// Structure-of-arrays view over a batch of curves, as consumed by `CCurves::CalcCurvePoints`.
+/// Every pointer must address at least as many elements as the batch count; no alignment is required.
+struct CCurveBatch
+{
+    const f32* StartX;
+    const f32* StartY;
+    const f32* StartZ;
+    const f32* EndX;
+    const f32* EndY;
+    const f32* EndZ;
+    const f32* StartDirX;
+    const f32* StartDirY;
+    const f32* StartDirZ;
+    const f32* EndDirX;
+    const f32* EndDirY;
+    const f32* EndDirZ;
+    const f32* Time;
+    const i32* TraverselTimeInMillis;
+};
+
+/// Structure-of-arrays output of `CCurves::CalcCurvePoints`, one element per curve in the batch.
+struct CCurveBatchResult
+{
+    f32* CoorX;
+    f32* CoorY;
+    f32* CoorZ;
+    f32* SpeedX;
+    f32* SpeedY;
+    f32* SpeedZ;
+};
+
+/// Per-curve invariants of `CCurves::CalcCurvePoint`, built once while a vehicle stays on a link.
+///
+/// Holds the speed variation, both line crossings and the segment split points so that evaluating the curve at a
+/// given time only does the branch and interpolation work, see `CCurves::CalcCurvePoint(const CCurveSegment&, ...)`.
+struct CCurveSegment
+{
+    CVector StartCoors;
+    CVector EndCoors;
+    CVector StartDir;
+    CVector EndDir;
+
+    f32 SpeedVariation;      // CalcSpeedVariationInBend
+    f32 DistToPoint1;        // start ray to end ray crossing
+    f32 DistToPoint2;        // end ray to start ray crossing (negated)
+    f32 StraightDist;        // 2D distance between start and end
+    f32 BendDistOneSegment;  // half the bend, at most 5 units
+    f32 StraightDist1;       // first straight, 0 when not crossing
+    f32 StraightDist2;       // second straight, 0 when not crossing
+    f32 BendDist;            // whole bend, or the corrected fallback distance when not crossing
+    f32 TotalDist_Time;      // length used for the speed, 0 when not crossing
+    bool bCrossing;          // false when the rays don't intersect properly and the fallback blend is used
+
+    CCurveSegment() {}
+    CCurveSegment(const CVector& startCoors, const CVector& endCoors, const CVector& startDir, const CVector& endDir);
+
+    /// The first Time `CCurves::CalcCurvePoint` puts on the second straight, which starts at `EndCoors` rather than
+    /// where the bend ends. 1.0 when the curve has no second straight.
+    f32 GetSecondStraightTime() const;
 };
 
+/// Everything the AI reads off a curve at a given time, as returned by `CCurves::CalcCurveState`.
+struct CCurveState
+{
+    CVector Coors;         // CalcCurvePoint resultCoor
+    CVector Speed;         // CalcCurvePoint resultSpeed
+    f32 TotalDist;         // length the speed is scaled with, 0 when not crossing (same as the game)
+    f32 SpeedVariation;    // CalcSpeedVariationInBend
+    f32 SpeedScaleFactor;  // CalcSpeedScaleFactor
+};
 
 class CCurves
 {
 public:
-    /// Runs the unit tests
+    /// Runs the unit tests, asserting on the first failure. Defined in tests.cpp, which needs neither the game nor
+    /// Windows, the `curves-tests` target runs them natively.
     static void TestCurves();
 
     /// Calculate the smallest distance needed for two mathematical lines to cross.
@@ -106,9 +195,90 @@ public:
     /// The function uses the `CalcCorrectedDist` function to account for speed variations along the curve,
     /// ensuring that the object's speed is adjusted appropriately based on the curve's geometry. The resulting
     /// position and speed are stored in `resultCoor` and `resultSpeed`, respectively.
+    ///
+    /// On a crossing curve the second straight starts at `endCoors` and runs on along `endDir`, the way the game's
+    /// formula has it: the point jumps from the end of the bend to `endCoors` and ends up `StraightDist2` units past
+    /// it at Time 1.0.
     static void CalcCurvePoint(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
         const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed);
 
+    /// Same as `CalcCurvePoint` with the branches replaced by selects.
+    ///
+    /// Computes the fallback path and all three sections of the crossing path and picks the result by the same
+    /// compares, so its cost doesn't depend on the curve or on how well the branches predict. Every call pays for the
+    /// fallback's sine and cosine, which makes it slower than `CalcCurvePoint` even on a random mix of curves (see
+    /// `curves-branch-bench`); use it where a fixed cost per call matters more than the average. Always the custom
+    /// implementation, bit-identical to it.
+    static void CalcCurvePointBranchless(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+        const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed);
+
+    /// Batched version of `CalcCurvePoint`, evaluates `Count` independent curves in one call.
+    /// \param curves Structure-of-arrays inputs, element `i` holds the arguments of the i-th `CalcCurvePoint` call.
+    /// \param Count The number of curves in the batch.
+    /// \param result Structure-of-arrays outputs, receives `resultCoor` and `resultSpeed` of every curve.
+    ///
+    /// The curves are processed 8 (AVX) or 4 (SSE2) at a time, every lane computes both the crossing and the
+    /// fallback path and the results are blended with the branch masks. Whatever doesn't fill a whole register
+    /// goes through the scalar `CalcCurvePoint`. Results match the scalar custom implementation within `Approx`.
+    static void CalcCurvePoints(const CCurveBatch& curves, u32 Count, const CCurveBatchResult& result);
+
+    /// Calculates a point on a prebuilt curve and the corresponding speed at a specified time.
+    /// \param segment The curve, built once from its start/end coordinates and directions.
+    /// \param Time The time parameter (typically normalized between 0.0 and 1.0) used to interpolate along the curve.
+    /// \param TraverselTimeInMillis The total traversal time in milliseconds for the curve.
+    /// \param resultCoor The resulting interpolated coordinates on the curve.
+    /// \param resultSpeed The resulting computed speed vector at the corresponding point on the curve.
+    ///
+    /// Same results as the `CalcCurvePoint` overload taking the four vectors, without recomputing the speed
+    /// variation, the line crossings and the segment lengths on every call.
+    static void CalcCurvePoint(
+        const CCurveSegment& segment, f32 Time, i32 TraverselTimeInMillis, CVector& resultCoor, CVector& resultSpeed);
+
+    /// Returns the speed scaling factor of a prebuilt curve, same as `CalcSpeedScaleFactor` on its inputs.
+    static f32 CalcSpeedScaleFactor(const CCurveSegment& segment);
+
+    /// Finds the time at which a prebuilt curve passes closest to a point.
+    /// \param segment The curve, built once from its start/end coordinates and directions.
+    /// \param point The position to measure from.
+    /// \param resultCoor Receives the closest point, the same as `CalcCurvePoint` returns at the returned time.
+    /// \return The time parameter of the closest point, within [0.0, 1.0].
+    ///
+    /// The two straights of a crossing curve are solved by projecting onto them, the bend (a quadratic in its
+    /// interpolation value) and the fallback blend by a few bracketed Newton steps between evenly spaced seeds. A
+    /// crossing curve costs about as much as three `CalcCurvePoint` calls, a fallback one about fifteen.
+    static f32 FindClosestTime(const CCurveSegment& segment, const CVector& point, CVector& resultCoor);
+
+    /// Samples a prebuilt curve as a polyline for drawing, with as few points as keep it within `Tolerance`.
+    /// \param segment The curve, built once from its start/end coordinates and directions.
+    /// \param Tolerance Largest distance in world units between the curve and the chord drawn for it.
+    /// \param pPoints Receives the points from the start to the end of the curve, may be null to only count them.
+    /// \param pTimes Receives the `Time` of every point, may be null.
+    /// \param MaxPoints Capacity of `pPoints` and `pTimes`, points past it are counted but not written.
+    /// \return The number of points of the polyline, more than `MaxPoints` if they didn't all fit.
+    ///
+    /// The straights of a crossing curve need only their ends. The bend is a quadratic in its interpolation value,
+    /// whose chords over even steps deviate from it by exactly the step squared times a constant, which gives the
+    /// number of steps up front. The fallback blend has no such bound and is split in halves until the middle of every
+    /// span, and 17 even samples of the whole curve, are within `Tolerance` of their chord. Nothing is allocated, the
+    /// points are the ones `CalcCurvePoint` returns at their times within rounding. The jump from the end of the bend
+    /// to the start of the second straight is drawn as a chord between two adjacent times.
+    static u32 CalcCurvePolyline(
+        const CCurveSegment& segment, f32 Tolerance, CVector* pPoints, f32* pTimes, u32 MaxPoints);
+
+    /// Fused `CalcSpeedVariationInBend`, `CalcSpeedScaleFactor` and `CalcCurvePoint` on the same curve.
+    /// \param startCoors The starting coordinates of the curve.
+    /// \param endCoors The ending coordinates of the curve.
+    /// \param startDir The starting direction vector.
+    /// \param endDir The ending direction vector.
+    /// \param Time The time parameter (typically normalized between 0.0 and 1.0) used to interpolate along the curve.
+    /// \param TraverselTimeInMillis The total traversal time in milliseconds for the curve.
+    /// \param result Receives the point, speed, distances and factors of the curve.
+    ///
+    /// The three functions each redo both line crossings and the speed variation branch, this does them once.
+    /// Results match the separate calls within `Approx`.
+    static void CalcCurveState(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+        const CVector& endDir, f32 Time, i32 TraverselTimeInMillis, CCurveState& result);
+
     /// Computes the total length of a curve defined by its start and end coordinates and directions.
     /// \param startCoors The starting coordinates of the curve.
     /// \param endCoors The ending coordinates of the curve.
@@ -116,16 +286,30 @@ public:
     /// \param endDir The ending direction vector.
     /// \param pLength Pointer to a variable where the computed curve length will be stored.
     ///
-    /// This function calculates the total length of a curve defined by its start and end points and their
-    /// corresponding direction vectors. The curve length is computed by integrating the distance along the
-    /// curve, taking into account the geometry of the bend.
+    /// This function calculates the world-space length of the path `CalcCurvePoint` traces for Time from 0.0 to
+    /// 1.0, which is not the distance `CalcSpeedScaleFactor` uses for the speed. The jump from the end of the bend to
+    /// the start of the second straight isn't part of it.
     ///
     /// The function uses the `DistForLineToCrossOtherLine` function to determine the intersection points
-    /// of the lines defined by the start and end points. If the lines do not intersect, the function falls
-    /// back to calculating the straight-line distance between the start and end points.
+    /// of the lines defined by the start and end points. The two straights before and after the crossing and the
+    /// bend between them have closed forms (the bend's velocity is linear in its interpolation value). If the lines
+    /// do not intersect, the speed of the fallback blend between the two rays is integrated by 8-point
+    /// Gauss-Legendre quadrature in eight panels, with a relative error below 4e-4.
     static void CalcCurveLength(const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
         const CVector& endDir, f32* pLength);
 
+    /// Returns the length of a prebuilt curve, see the `CalcCurveLength` overload taking the four vectors.
+    ///
+    /// Costs an `asinh` for a crossing curve and 64 square roots for the fallback blend, with no trig: the
+    /// quadrature nodes are fixed, so the sines and cosines `CalcCorrectedDist` takes there are compile-time tables.
+    static f32 CalcCurveLength(const CCurveSegment& segment);
+
+    /// `CalcCurveLength` over an array of prebuilt curves, e.g. every link of a path network after loading it.
+    /// \param pSegments The curves.
+    /// \param Count Number of curves in `pSegments` and lengths written to `pLengths`.
+    /// \param pLengths Receives the length of every curve.
+    static void CalcCurveLengths(const CCurveSegment* pSegments, u32 Count, f32* pLengths);
+
     /// Calculates a corrected distance along the curve that accounts for speed variation.
     /// \param Current The current progression along the curve.
     /// \param Total The total progression or length of the curve.
@@ -141,4 +325,13 @@ public:
     /// speed is appropriately scaled based on the sharpness of the curve. The function also provides an
     /// interpolation value (`pInterPol`) that can be used for further calculations or visual effects.
     static f32 CalcCorrectedDist(f32 Current, f32 Total, f32 SpeedVariation, f32* pInterPol);
+
+    /// Same as `CalcCorrectedDist` with the `CCurveFast` precision policy, the sine and cosine are replaced by
+    /// `CMaths::FastSin` / `CMaths::FastCos` and the divisions by reciprocal estimates.
+    ///
+    /// For `Current` within [0, Total], which is all `CalcCurvePoint` passes, the polynomials add at most
+    /// 2.2e-7 * Total * SpeedVariation / (2 * PI) to the error of the returned distance and 1e-7 to the interpolation
+    /// value. Other values of `Current` use the libm sine and cosine. Building the custom implementation with
+    /// `USE_FAST_TRIG` makes all of `CCurves` (and `CalcCurvePoints`) use the `CCurveFast` policy.
+    static f32 CalcCorrectedDistFast(f32 Current, f32 Total, f32 SpeedVariation, f32* pInterPol);
 };
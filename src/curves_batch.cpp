@@ -0,0 +1,247 @@
+#include "curve_stats.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CURVES_BATCH_SSE 1
+#include <immintrin.h>
+#endif
+
+#if defined(CURVES_BATCH_SSE) && defined(__AVX__)
+#define CURVES_BATCH_AVX 1
+#endif
+
+namespace
+{
+#ifdef CURVES_BATCH_SSE
+// 4 lanes of f32, masks are all-ones/all-zeros lanes like the compare intrinsics return them
+struct F4
+{
+    static constexpr u32 Width = 4;
+
+    __m128 v;
+
+    F4(__m128 _v) : v(_v) {}
+    F4(f32 s) : v(_mm_set1_ps(s)) {}
+
+    static F4 Load(const f32* p) { return _mm_loadu_ps(p); }
+    static F4 Load(const i32* p) { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    void Store(f32* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline F4 operator+(F4 a, F4 b) { return _mm_add_ps(a.v, b.v); }
+inline F4 operator-(F4 a, F4 b) { return _mm_sub_ps(a.v, b.v); }
+inline F4 operator*(F4 a, F4 b) { return _mm_mul_ps(a.v, b.v); }
+inline F4 operator/(F4 a, F4 b) { return _mm_div_ps(a.v, b.v); }
+inline F4 operator-(F4 a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+inline F4 operator<(F4 a, F4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline F4 operator<=(F4 a, F4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline F4 operator>(F4 a, F4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline F4 operator>=(F4 a, F4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline F4 operator==(F4 a, F4 b) { return _mm_cmpeq_ps(a.v, b.v); }
+inline F4 operator|(F4 a, F4 b) { return _mm_or_ps(a.v, b.v); }
+inline F4 Min(F4 a, F4 b) { return _mm_min_ps(a.v, b.v); }
+inline F4 Max(F4 a, F4 b) { return _mm_max_ps(a.v, b.v); }
+inline F4 Sqrt(F4 a) { return _mm_sqrt_ps(a.v); }
+inline F4 Select(F4 mask, F4 a, F4 b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+inline bool Any(F4 mask) { return _mm_movemask_ps(mask.v) != 0; }
+#endif
+
+#ifdef CURVES_BATCH_AVX
+// 8 lanes of f32
+struct F8
+{
+    static constexpr u32 Width = 8;
+
+    __m256 v;
+
+    F8(__m256 _v) : v(_v) {}
+    F8(f32 s) : v(_mm256_set1_ps(s)) {}
+
+    static F8 Load(const f32* p) { return _mm256_loadu_ps(p); }
+    static F8 Load(const i32* p) { return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    void Store(f32* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline F8 operator+(F8 a, F8 b) { return _mm256_add_ps(a.v, b.v); }
+inline F8 operator-(F8 a, F8 b) { return _mm256_sub_ps(a.v, b.v); }
+inline F8 operator*(F8 a, F8 b) { return _mm256_mul_ps(a.v, b.v); }
+inline F8 operator/(F8 a, F8 b) { return _mm256_div_ps(a.v, b.v); }
+inline F8 operator-(F8 a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+inline F8 operator<(F8 a, F8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline F8 operator<=(F8 a, F8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+inline F8 operator>(F8 a, F8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+inline F8 operator>=(F8 a, F8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+inline F8 operator==(F8 a, F8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ); }
+inline F8 operator|(F8 a, F8 b) { return _mm256_or_ps(a.v, b.v); }
+inline F8 Min(F8 a, F8 b) { return _mm256_min_ps(a.v, b.v); }
+inline F8 Max(F8 a, F8 b) { return _mm256_max_ps(a.v, b.v); }
+inline F8 Sqrt(F8 a) { return _mm256_sqrt_ps(a.v); }
+inline F8 Select(F8 mask, F8 a, F8 b) { return _mm256_blendv_ps(b.v, a.v, mask.v); }
+inline bool Any(F8 mask) { return _mm256_movemask_ps(mask.v) != 0; }
+#endif
+
+#ifdef USE_FAST_TRIG
+// CMaths::FastSin and CMaths::FastCos on whole registers
+template <typename P>
+P FastSin(P x)
+{
+    const P y = x - PI;
+    return -CMaths::FastSinPoly(Select(y > HALF_PI, PI - y, Select(y < -HALF_PI, -PI - y, y)));
+}
+
+template <typename P>
+P FastCos(P x)
+{
+    return CMaths::FastSinPoly(HALF_PI - x);
+}
+#endif
+
+// Same math as the custom CCurves::CalcCurvePoint, with every branch evaluated and blended per lane
+template <typename P>
+void CalcCurvePointsKernel(const CCurveBatch& c, u32 i, const CCurveBatchResult& r)
+{
+    const P sx = P::Load(c.StartX + i), sy = P::Load(c.StartY + i), sz = P::Load(c.StartZ + i);
+    const P ex = P::Load(c.EndX + i), ey = P::Load(c.EndY + i), ez = P::Load(c.EndZ + i);
+    const P sdx = P::Load(c.StartDirX + i), sdy = P::Load(c.StartDirY + i), sdz = P::Load(c.StartDirZ + i);
+    const P edx = P::Load(c.EndDirX + i), edy = P::Load(c.EndDirY + i), edz = P::Load(c.EndDirZ + i);
+    const P OurTime = Min(Max(P::Load(c.Time + i), 0.0f), 1.0f);
+    const P timeScale = P::Load(c.TraverselTimeInMillis + i) * 0.001f;
+
+    // CalcSpeedVariationInBend
+    const P dx = sx - ex;
+    const P dy = sy - ey;
+    const P StraightDist = Sqrt(dx * dx + dy * dy);
+    const P DotProduct = sdx * edx + sdy * edy;
+    const P LineDot = dx * edx + dy * edy;
+    const P DistToLine = Sqrt(Max(dx * dx + dy * dy - LineDot * LineDot, 0.0f));
+    const P SpeedVariation = Select(DotProduct <= 0.0f, 1.0f / 3.0f,
+        Select(DotProduct <= 0.7f, (1.0f - (DotProduct / 0.7f)) * (1.0f / 3.0f),
+            (DistToLine / StraightDist) * (1.0f / 3.0f)));
+
+    // DistForLineToCrossOtherLine, both ways
+    const P Dir1 = sdx * edy - sdy * edx;
+    const P DistToPoint1 = Select(Dir1 == 0.0f, -1.0f, -(dx * edy - dy * edx) / Dir1);
+    const P Dir2 = edx * sdy - edy * sdx;
+    const P DistToPoint2 = -Select(Dir2 == 0.0f, -1.0f, -((ex - sx) * sdy - (ey - sy) * sdx) / Dir2);
+
+    const P fallback = (DistToPoint1 <= 0.0f) | (DistToPoint2 <= 0.0f);
+
+    // Three-segment path for properly intersecting rays
+    const P BendDistOneSegment = Min(Min(DistToPoint1, DistToPoint2), 5.0f);
+    const P StraightDist1 = DistToPoint1 - BendDistOneSegment;
+    const P StraightDist2 = DistToPoint2 - BendDistOneSegment;
+    const P BendDist = BendDistOneSegment * 2.0f;
+    const P TotalDist_Time = Select(fallback, 0.0f, StraightDist1 + BendDist + StraightDist2);
+    const P distanceAtTime = TotalDist_Time * OurTime;
+
+    const P onFirst = distanceAtTime < StraightDist1;
+    const P onSecond = distanceAtTime > (StraightDist1 + BendDist);
+    const P secondSegmentDist = distanceAtTime - (StraightDist1 + BendDist);
+    const P BendInter = (distanceAtTime - StraightDist1) / BendDist;
+    const P oneMinusBendInter = 1.0f - BendInter;
+    const P startInfluence = StraightDist1 + BendDistOneSegment * BendInter;
+    const P endInfluence = StraightDist2 + BendDistOneSegment * oneMinusBendInter;
+
+    auto crossing = [&](P s, P e, P sd, P ed)
+    {
+        const P bend = (s + sd * startInfluence) * oneMinusBendInter + (e - ed * endInfluence) * BendInter;
+        return Select(onFirst, s + sd * distanceAtTime, Select(onSecond, e + ed * secondSegmentDist, bend));
+    };
+
+    P cx = crossing(sx, ex, sdx, edx);
+    P cy = crossing(sy, ey, sdy, edy);
+    P cz = crossing(sz, ez, sdz, edz);
+
+    if (Any(fallback))
+    {
+        // Non-crossing rays, blend the two projected positions like CalcCorrectedDist does
+        const P FallbackBendDist = StraightDist / (1.0f - SpeedVariation);
+        const P BendDist_Time = FallbackBendDist * OurTime;
+        const P valid = FallbackBendDist >= 0.00001f;
+
+        const P sinArg = (BendDist_Time * TWO_PI) / FallbackBendDist;
+        const P cosArg = (BendDist_Time / FallbackBendDist) * PI;
+
+#ifdef USE_FAST_TRIG
+        const P sinValue = FastSin(sinArg);
+        const P cosValue = FastCos(cosArg);
+#else
+        alignas(32) f32 sinLanes[P::Width];
+        alignas(32) f32 cosLanes[P::Width];
+        sinArg.Store(sinLanes);
+        cosArg.Store(cosLanes);
+        for (u32 k = 0; k < P::Width; k++)
+        {
+            sinLanes[k] = CMaths::Sin(sinLanes[k]);
+            cosLanes[k] = CMaths::Cos(cosLanes[k]);
+        }
+
+        const P sinValue = P::Load(sinLanes);
+        const P cosValue = P::Load(cosLanes);
+#endif
+
+        const P AverageSpeed = (FallbackBendDist / TWO_PI) * SpeedVariation;
+        const P CurrentDist_Time = Select(valid,
+            (((SpeedVariation * -2.0f) + 2.0f) * 0.5f * BendDist_Time) + AverageSpeed * sinValue, 0.0f);
+        const P Interpol = Select(valid, 0.5f - cosValue * 0.5f, 0.5f);
+        const P oneMinusInterpol = 1.0f - Interpol;
+        const P distDiff = CurrentDist_Time - StraightDist;
+
+        cx = Select(fallback, (sx + sdx * CurrentDist_Time) * oneMinusInterpol + (ex + edx * distDiff) * Interpol, cx);
+        cy = Select(fallback, (sy + sdy * CurrentDist_Time) * oneMinusInterpol + (ey + edy * distDiff) * Interpol, cy);
+        cz = Select(fallback, (sz + sdz * CurrentDist_Time) * oneMinusInterpol + (ez + edz * distDiff) * Interpol, cz);
+    }
+
+    cx.Store(r.CoorX + i);
+    cy.Store(r.CoorY + i);
+    cz.Store(r.CoorZ + i);
+
+    const P t1 = 1.0f - OurTime;
+    const P speed = TotalDist_Time / timeScale;
+    ((edx * OurTime + sdx * t1) * speed).Store(r.SpeedX + i);
+    ((edy * OurTime + sdy * t1) * speed).Store(r.SpeedY + i);
+    P(0.0f).Store(r.SpeedZ + i);
+}
+}  // namespace
+
+void CCurves::CalcCurvePoints(const CCurveBatch& curves, u32 Count, const CCurveBatchResult& result)
+{
+    // the kernels don't branch, only the leftovers going through CalcCurvePoint show up in its counters
+    CURVE_STAT_ADD(CURVE_POINTS_BATCHED, Count);
+
+    u32 i = 0;
+
+#ifdef CURVES_BATCH_AVX
+    for (; i + F8::Width <= Count; i += F8::Width)
+    {
+        CalcCurvePointsKernel<F8>(curves, i, result);
+    }
+#endif
+
+#ifdef CURVES_BATCH_SSE
+    for (; i + F4::Width <= Count; i += F4::Width)
+    {
+        CalcCurvePointsKernel<F4>(curves, i, result);
+    }
+#endif
+
+    // Leftovers that don't fill a register
+    for (; i < Count; i++)
+    {
+        CVector resultCoor;
+        CVector resultSpeed;
+        CalcCurvePoint(CVector(curves.StartX[i], curves.StartY[i], curves.StartZ[i]),
+            CVector(curves.EndX[i], curves.EndY[i], curves.EndZ[i]),
+            CVector(curves.StartDirX[i], curves.StartDirY[i], curves.StartDirZ[i]),
+            CVector(curves.EndDirX[i], curves.EndDirY[i], curves.EndDirZ[i]), curves.Time[i],
+            curves.TraverselTimeInMillis[i], resultCoor, resultSpeed);
+
+        result.CoorX[i] = resultCoor.x;
+        result.CoorY[i] = resultCoor.y;
+        result.CoorZ[i] = resultCoor.z;
+        result.SpeedX[i] = resultSpeed.x;
+        result.SpeedY[i] = resultSpeed.y;
+        result.SpeedZ[i] = resultSpeed.z;
+    }
+}
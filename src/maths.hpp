@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "curves.hpp"
+
+// minimal CMaths/CCollision, only the bits the custom curve implementation needs
+
+constexpr f32 PI = 3.14159265358979323846f;
+constexpr f32 TWO_PI = 6.28318530717958647692f;
+constexpr f32 HALF_PI = 1.57079632679489661923f;
+
+#define VCLAMP(lo, hi, v) (std::min(std::max((v), (lo)), (hi)))
+
+class CMaths
+{
+public:
+    // libm at runtime, series evaluated in double during constant evaluation
+    static constexpr f32 Sin(f32 x)
+    {
+        if consteval
+        {
+            return static_cast<f32>(ConstexprSin(x));
+        }
+        else
+        {
+            return std::sin(x);
+        }
+    }
+
+    static constexpr f32 Cos(f32 x)
+    {
+        if consteval
+        {
+            return static_cast<f32>(ConstexprSin(x + 1.57079632679489661923));
+        }
+        else
+        {
+            return std::cos(x);
+        }
+    }
+
+    static constexpr f32 Sqrt(f32 x)
+    {
+        if consteval
+        {
+            return static_cast<f32>(ConstexprSqrt(x));
+        }
+        else
+        {
+            return std::sqrt(x);
+        }
+    }
+
+    static constexpr f32 Min(f32 a, f32 b) { return std::min(a, b); }
+
+    /// Polynomial sine for the arguments of `CCurves::CalcCorrectedDistFast`, only valid on [0, 2*PI].
+    ///
+    /// Max absolute error against the exact sine is 2.2e-7 on that range (libm's sinf is 3.3e-8), at roughly
+    /// half the cost of libm. There is no range reduction, arguments outside [-PI/2, 5*PI/2] give garbage.
+    static f32 FastSin(f32 x)
+    {
+        // sin(x) = -sin(x - PI), then fold onto [-PI/2, PI/2] where the polynomial is fitted: y past +-PI/2 becomes
+        // +-PI - y, sin(PI - y) = sin(y). Written as selects so it compiles without branches. At exactly +-PI/2
+        // the compare keeps y unfolded, folding would give the same +-PI/2 (PI - PI/2 is exact in float), so
+        // either side of the boundary is fine.
+        const f32 y = x - PI;
+        const f32 folded = std::copysign(PI, y) - y;
+        return -FastSinPoly(std::fabs(y) > HALF_PI ? folded : y);
+    }
+
+    /// Polynomial cosine, only valid on [0, PI] (exact up to [-PI/2, 3*PI/2]). Max absolute error is 1.9e-7.
+    static f32 FastCos(f32 x) { return FastSinPoly(HALF_PI - x); }
+
+    /// Degree 9 minimax fit of sine on [-PI/2, PI/2], 3.4e-9 before float rounding.
+    /// A template so the batched kernels can run it on whole registers.
+    template <typename T>
+    static T FastSinPoly(T x)
+    {
+        const T x2 = x * x;
+        return x * (0.99999997659f +
+                       x2 * (-0.16666647635f +
+                                x2 * (0.0083328998234f + x2 * (-1.9800897763e-4f + x2 * 2.5904885014e-6f))));
+    }
+
+private:
+    // reduces to [-PI, PI], 30 Taylor terms are past double precision there
+    static constexpr f64 ConstexprSin(f64 x)
+    {
+        constexpr f64 period = 6.28318530717958647692;
+        const f64 turns = x / period;
+        x -= period * static_cast<f64>(static_cast<long long>(turns + (turns < 0.0 ? -0.5 : 0.5)));
+
+        f64 term = x;
+        f64 sum = x;
+        for (i32 n = 1; n < 30; n++)
+        {
+            term *= -x * x / static_cast<f64>((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static constexpr f64 ConstexprSqrt(f64 x)
+    {
+        if (x < 0.0)
+        {
+            return std::numeric_limits<f64>::quiet_NaN();
+        }
+        if (x == 0.0 || x == std::numeric_limits<f64>::infinity())
+        {
+            return x;
+        }
+
+        // Newton-Raphson from above converges monotonically, stop once it doesn't move anymore
+        f64 root = x > 1.0 ? x : 1.0;
+        for (;;)
+        {
+            const f64 next = 0.5 * (root + x / root);
+            if (next >= root)
+            {
+                return root;
+            }
+            root = next;
+        }
+    }
+};
+
+class CCollision
+{
+public:
+    /// Distance of the point (PointX, PointY) to the infinite line through (LineBaseX, LineBaseY) along the
+    /// normalized direction (LineDirX, LineDirY).
+    static constexpr f32 DistToMathematicalLine2D(
+        f32 LineBaseX, f32 LineBaseY, f32 LineDirX, f32 LineDirY, f32 PointX, f32 PointY)
+    {
+        const f32 px = PointX - LineBaseX;
+        const f32 py = PointY - LineBaseY;
+        const f32 dot = px * LineDirX + py * LineDirY;
+        const f32 distSq = px * px + py * py - dot * dot;
+        return distSq <= 0.0f ? 0.0f : CMaths::Sqrt(distSq);
+    }
+};
@@ -0,0 +1,1885 @@
+// The TestCurves cases, no game or Windows needed. The .asi runs them under the debugger, tests/run_tests.cpp natively
+
+// The cases are asserts, release builds (NDEBUG) would compile every check out and pass without testing anything
+#undef NDEBUG
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "curve_arc_length.hpp"
+#include "curve_bvh.hpp"
+#include "curve_compact.hpp"
+#include "curve_conflicts.hpp"
+#include "curve_corpus.hpp"
+#include "curve_cursor.hpp"
+#include "curve_math.hpp"
+#include "curve_network.hpp"
+#include "curve_route.hpp"
+#include "curve_stats.hpp"
+#include "curve_thread_pool.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+#include "vector_simd.hpp"
+#include "approx.hpp"
+
+// #define epsilon 0.0000001f
+// #define FLOAT_EQUAL(a, b) (fabs((a) - (b)) < (epsilon))
+
+#define FLOAT_EQUAL(a, b) ((a) == Approx(b))
+
+void CCurves::TestCurves()
+{
+    // Lane changes, bends, u-turns and fallbacks with their headings a golden angle apart, starting at `center` or,
+    // with a `Spread`, scattered over a `Spread` x `Spread` area around it
+    const auto ScatteredSegments =
+        [](u32 Count, const CVector& center, u32 Spread, f32 MinLength, f32 LengthStep, f32 Slope)
+    {
+        std::vector<CCurveSegment> segments;
+        for (u32 i = 0; i < Count; i++)
+        {
+            const f32 heading = static_cast<f32>(i) * 2.39996f;
+            const f32 turn = static_cast<f32>(i % 13) * 0.5f - 3.0f;
+            const f32 length = MinLength + static_cast<f32>(i % 7) * LengthStep;
+            CVector startCoors = center;
+            if (Spread > 0)
+            {
+                startCoors = startCoors + CVector(static_cast<f32>((i * 37) % Spread) - static_cast<f32>(Spread) * 0.5f,
+                    static_cast<f32>((i * 91) % Spread) - static_cast<f32>(Spread) * 0.5f, static_cast<f32>(i % 3));
+            }
+            const CVector startDir(std::cos(heading), std::sin(heading), 0.0f);
+            const CVector endDir(std::cos(heading + turn), std::sin(heading + turn), 0.0f);
+            const CVector offset(std::cos(heading + turn * 0.3f), std::sin(heading + turn * 0.3f), Slope);
+            segments.emplace_back(startCoors, startCoors + offset * length, startDir, endDir);
+        }
+        return segments;
+    };
+
+    // World-space distance CalcCurvePoint moves from prevCoor at prevTime to coor at Time, leaving out the jump
+    // from the end of the bend to EndCoors where the second straight starts
+    const auto PathStep = [](const CCurveSegment& segment, f32 prevTime, const CVector& prevCoor, f32 Time,
+                              const CVector& coor)
+    {
+        const f32 bendEndDist = segment.StraightDist1 + segment.BendDist;
+        if (segment.bCrossing && !(segment.TotalDist_Time * VCLAMP(0.0f, 1.0f, prevTime) > bendEndDist) &&
+            segment.TotalDist_Time * VCLAMP(0.0f, 1.0f, Time) > bendEndDist)
+        {
+            const CVector bendEnd = segment.EndCoors - segment.EndDir * segment.StraightDist2;
+            return (bendEnd - prevCoor).Magnitude() + (coor - segment.EndCoors).Magnitude();
+        }
+        return (coor - prevCoor).Magnitude();
+    };
+
+    // A few hand-picked curves, one of each kind, for the tests comparing two ways of evaluating the same curve
+    struct CTestCurve
+    {
+        CVector startCoors, endCoors, startDir, endDir;
+    };
+
+    const CTestCurve TestCurveSet[] = {
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},        // straight line
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},        // short bend
+        {{0.0f, 0.0f, 0.0f}, {1000.0f, 1000.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},  // long straights
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}},        // z-axis movement
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}},       // opposite
+        {{2500.0f, 1500.0f, 10.0f}, {2520.0f, 1512.0f, 12.0f}, {0.8f, 0.6f, 0.0f}, {0.6f, 0.8f, 0.0f}},
+    };
+
+    auto DistForLineToCrossOtherLine_test = []
+    {
+        // Test case 1: Lines intersect
+        {
+            f32 result = DistForLineToCrossOtherLine(0.0f, 0.0f, 1.0f, 1.0f,  // Line 1: base (0,0), direction (1,1)
+                1.0f, 0.0f, -1.0f, 1.0f                                       // Line 2: base (1,0), direction (-1,1)
+            );
+
+            // 0.5
+            assert(FLOAT_EQUAL(result, 0.5f));  // Expected distance to crossing
+        }
+
+        // Test case 2: Lines are parallel (no intersection)
+        {
+            f32 result = DistForLineToCrossOtherLine(0.0f, 0.0f, 1.0f, 1.0f,  // Line 1: base (0,0), direction (1,1)
+                1.0f, 1.0f, 1.0f, 1.0f                                        // Line 2: base (1,1), direction (1,1)
+            );
+
+            // -1
+            assert(FLOAT_EQUAL(result, -1.0f));  // Expected -1 for parallel lines
+        }
+
+        // Test case 3: Lines intersect at a point
+        {
+            f32 result = DistForLineToCrossOtherLine(0.0f, 0.0f, 2.0f, 2.0f,  // Line 1: base (0,0), direction (2,2)
+                0.0f, 4.0f, 2.0f, -2.0f                                       // Line 2: base (0,4), direction (2,-2)
+            );
+
+            // 1.0
+            assert(FLOAT_EQUAL(result, 1.0f));  // Expected distance to crossing
+        }
+
+        // Test case 4: Lines are coincident (infinite intersections)
+        {
+            f32 result = DistForLineToCrossOtherLine(0.0f, 0.0f, 1.0f, 1.0f,  // Line 1: base (0,0), direction (1,1)
+                1.0f, 1.0f, 2.0f, 2.0f                                        // Line 2: base (1,1), direction (2,2)
+            );
+
+            // -1
+            assert(FLOAT_EQUAL(result, -1.0f));  // Expected -1 for coincident lines
+        }
+
+        // Test case 5: Lines with large numbers
+        {
+            f32 result = DistForLineToCrossOtherLine(
+                2500.5f, 1500.0f, 3.5f, 2.5f,  // Line 1: base (2500.5,1500), direction (3.5,2.5)
+                3000.0f, 2000.0f, -4.0f, 3.0f  // Line 2: base (3000,2000), direction (-4,3)
+            );
+
+            // Should still give a reasonable intersection distance
+            assert(FLOAT_EQUAL(result, 170.658539f));  // Expected distance to crossing
+        }
+    };
+
+    auto CalcSpeedVariationInBend_test = []
+    {
+        // Test Case 1: Dot product <= 0 (opposite directions)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, -1.0f, 0.0f);  // Opposite directions
+            assert(FLOAT_EQUAL(speedVariation, 1.0f / 3.0f) && "Test Case 1 Failed: Expected 0.33333.");
+        }
+
+        // Test Case 2: Dot product <= 0 (perpendicular directions)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);  // Perpendicular directions
+            assert(FLOAT_EQUAL(speedVariation, 1.0f / 3.0f) && "Test Case 2 Failed: Expected 0.33333.");
+        }
+
+        // Test Case 3: Dot product <= 0.7 (small angle)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedVariation = CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.9f, 0.1f);  // Small angle
+            assert(FLOAT_EQUAL(speedVariation, 0.145296633f) &&
+                   "Test Case 3 Failed: Expected value between 0 and 0.33333.");
+        }
+
+        // Test Case 4: Dot product > 0.7 (larger angle)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.8f, 0.2f);  // Larger angle
+            assert(FLOAT_EQUAL(speedVariation, 0.235702246f) &&
+                   "Test Case 4 Failed: Expected value between 0 and 0.33333.");
+        }
+
+        // Test Case 5: Dot product = 0.7 (boundary case)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.7f, 0.7141428f);  // Dot product = 0.7
+            assert(FLOAT_EQUAL(speedVariation, 0.0f) && "Test Case 5 Failed: Expected 0.0.");
+        }
+
+        // Test Case 6: Dot product > 0.7 (sharp bend)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedVariation = CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.6f, 0.8f);  // Sharp bend
+            assert(
+                FLOAT_EQUAL(speedVariation, 0.047619f) && "Test Case 6 Failed: Expected value between 0 and 0.33333.");
+        }
+
+        // Test Case 7: Dot product = 1 (same direction)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 1.0f, 0.0f);  // Same direction
+            assert(speedVariation == 0.0f && "Test Case 7 Failed: Expected 0.0.");
+        }
+
+        // Test Case 8: Dot product > 0.7 (perpendicular distance calculation)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);  // Perpendicular directions
+            assert(speedVariation > 0.0f && speedVariation <= (1.0f / 3.0f) &&
+                   "Test Case 8 Failed: Expected value between 0 and 0.33333.");
+        }
+
+        // Test Case 9: Dot product > 0.7 (large perpendicular distance)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(10.0f, 0.0f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);  // Large perpendicular distance
+            assert(speedVariation > 0.0f && speedVariation <= (1.0f / 3.0f) &&
+                   "Test Case 9 Failed: Expected value between 0 and 0.33333.");
+        }
+
+        // Test Case 10: Dot product > 0.7 (small perpendicular distance)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.1f, 0.0f);
+            f32 speedVariation =
+                CalcSpeedVariationInBend(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);  // Small perpendicular distance
+            assert(speedVariation > 0.0f && speedVariation <= (1.0f / 3.0f) &&
+                   "Test Case 10 Failed: Expected value between 0 and 0.33333.");
+        }
+    };
+
+    auto CalcSpeedScaleFactor_test = []
+    {
+        // Test Case 1: CalcSpeedScaleFactor - Simple Bend
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);
+
+            // 2.0
+            assert(FLOAT_EQUAL(speedScaleFactor, 2.0f) && "Test Case Failed: Incorrect speed scale factor.");
+        }
+
+        // Test Case 2: CalcSpeedScaleFactor - Straight Line
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 1.0f, 0.0f, 1.0f, 0.0f);
+
+            // 1.0
+            assert(FLOAT_EQUAL(speedScaleFactor, 1.0f) && "Test Case Failed: Incorrect speed scale factor.");
+        }
+
+        // Test Case 3: CalcSpeedScaleFactor - Sharp Bend
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 1.0f, 0.0f, 0.0f, 1.0f);
+
+            // 1.5
+            assert(FLOAT_EQUAL(speedScaleFactor, 1.5f) &&
+                   "Test Case Failed: Speed scale factor should be greater than 1.0.");
+        }
+
+        // Test Case 4: CalcSpeedScaleFactor - Parallel Lines
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 1.0f, 0.0f, 1.0f, 0.0f);
+
+            // 1.0
+            assert(FLOAT_EQUAL(speedScaleFactor, 1.0f) && "Test Case Failed: Incorrect speed scale factor.");
+        }
+
+        // Test Case 5: CalcSpeedScaleFactor - Coincident Lines
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 1.0f, 1.0f, 1.0f, 1.0f);
+
+            // ~1.41
+            assert(FLOAT_EQUAL(speedScaleFactor, 1.4142135f) && "Test Case Failed: Incorrect speed scale factor.");
+        }
+
+        // Test Case 6: CalcSpeedScaleFactor - Large Values
+        {
+            CVector startCoors(2500.0f, 1500.0f, 0.0f);
+            CVector endCoors(3500.0f, 2000.0f, 0.0f);
+            f32 speedScaleFactor = CalcSpeedScaleFactor(startCoors, endCoors, 2.0f, 1.0f, 3.0f, 2.0f);
+
+            // Should be a reasonable scale factor despite large coordinates
+            assert(FLOAT_EQUAL(speedScaleFactor, 1118.03394f) &&
+                   "Test Case Failed: Speed scale factor out of reasonable range for large values.");
+        }
+    };
+
+    auto CalcCurvePoint_test = []
+    {
+        // Test Case 1: CalcCurvePoint - Straight Line
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(1.0f, 0.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+
+            assert(FLOAT_EQUAL(resultCoor.x, 0.5f) && FLOAT_EQUAL(resultCoor.y, 0.0f) &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 1 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 2: CalcCurvePoint - Curve with Bend
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(0.0f, 1.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+
+            // Expected result depends on the interpolation logic
+            assert(resultCoor.x > 0.0f && resultCoor.x < 1.0f && resultCoor.y > 0.0f && resultCoor.y < 1.0f &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 2 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 3: CalcCurvePoint - Large Values
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1000.0f, 1000.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(0.0f, 1.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+
+            // Expected result depends on the interpolation logic
+            assert(resultCoor.x > 0.0f && resultCoor.x < 1000.0f && resultCoor.y > 0.0f && resultCoor.y < 1000.0f &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 3 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 4: CalcCurvePoint - Time = 0.0 (Start Point)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(0.0f, 1.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.0f, 1000, resultCoor, resultSpeed);
+
+            assert(FLOAT_EQUAL(resultCoor.x, 0.0f) && FLOAT_EQUAL(resultCoor.y, 0.0f) &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 4 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 5: CalcCurvePoint - Time = 1.0 (End Point)
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 1.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(0.0f, 1.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 1.0f, 1000, resultCoor, resultSpeed);
+
+            assert(FLOAT_EQUAL(resultCoor.x, 1.0f) && FLOAT_EQUAL(resultCoor.y, 1.0f) &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 5 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 6: CalcCurvePoint - Z-Axis Movement
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(0.0f, 0.0f, 1.0f);
+            CVector startDir(0.0f, 0.0f, 1.0f);
+            CVector endDir(0.0f, 0.0f, 1.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+
+            assert(FLOAT_EQUAL(resultCoor.x, 0.0f) && FLOAT_EQUAL(resultCoor.y, 0.0f) &&
+                   FLOAT_EQUAL(resultCoor.z, 0.5f) && "Test Case 6 Failed: Incorrect curve point.");
+        }
+
+        // Test Case 7: CalcCurvePoint - Sharp Bend
+        {
+            CVector startCoors(0.0f, 0.0f, 0.0f);
+            CVector endCoors(1.0f, 0.0f, 0.0f);
+            CVector startDir(1.0f, 0.0f, 0.0f);
+            CVector endDir(-1.0f, 0.0f, 0.0f);
+            CVector resultCoor;
+            CVector resultSpeed;
+            CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+
+            // Expected result depends on the interpolation logic
+            assert(FLOAT_EQUAL(resultCoor.x, 1.0f) && FLOAT_EQUAL(resultCoor.y, 0.0f) &&
+                   FLOAT_EQUAL(resultCoor.z, 0.0f) && "Test Case 7 Failed: Incorrect curve point.");
+        }
+    };
+
+    auto CalcCorrectedDist_test = []
+    {
+        // Test Case 1: CalcCorrectedDist - Simple Case
+        {
+            // interpol please don't arrest us, we have done nothing!
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.5f, 1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.25f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 1 Failed: Corrected distance out of range.");
+        }
+        // Test Case 2: CalcCorrectedDist - Start of Curve (Time = 0.0)
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.0f, 1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.0f) && FLOAT_EQUAL(interpol, 0.0f) &&
+                   "Test Case 2 Failed: Corrected distance should be 0.0 at the start.");
+        }
+
+        // Test Case 3: CalcCorrectedDist - End of Curve (Time = 1.0)
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(1.0f, 1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.5f) && FLOAT_EQUAL(interpol, 1.0f) &&
+                   "Test Case 3 Failed: Corrected distance should be 1.0 at the end.");
+        }
+
+        // Test Case 4: CalcCorrectedDist - No Speed Variation (SpeedVariation = 0.0)
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.5f, 1.0f, 0.0f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.5f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 4 Failed: Corrected distance should match input when SpeedVariation is 0.0.");
+        }
+
+        // Test Case 5: CalcCorrectedDist - Maximum Speed Variation (SpeedVariation = 1.0)
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.5f, 1.0f, 1.0f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.0f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 5 Failed: Corrected distance should be 0.0 when SpeedVariation is 1.0.");
+        }
+
+        // Test Case 6: CalcCorrectedDist - Large Total Distance
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(500.0f, 1000.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 250.0f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 6 Failed: Corrected distance should scale with large Total distance.");
+        }
+
+        // Test Case 7: CalcCorrectedDist - Small Total Distance
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.1f, 0.2f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.05f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 7 Failed: Corrected distance should scale with small Total distance.");
+        }
+
+        // Test Case 8: CalcCorrectedDist - Negative Current Distance
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(-0.5f, 1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, -0.25f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 8 Failed: Corrected distance should handle negative Current distance.");
+        }
+
+        // Test Case 9: CalcCorrectedDist - Negative Total Distance
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.5f, -1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.0f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 9 Failed: Corrected distance should handle negative Total distance.");
+        }
+
+        // Test Case 10: CalcCorrectedDist - SpeedVariation > 1.0
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDist(0.5f, 1.0f, 1.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, -0.25f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 10 Failed: Corrected distance should handle SpeedVariation > 1.0.");
+        }
+    };
+
+    auto CalcCurvePoints_test = []
+    {
+        // Test Case 1: CalcCurvePoints - Batch matches CalcCurvePoint on every lane, including the scalar tail
+        {
+            constexpr u32 Count = 37;
+            f32 startX[Count], startY[Count], startZ[Count], endX[Count], endY[Count], endZ[Count];
+            f32 startDirX[Count], startDirY[Count], startDirZ[Count], endDirX[Count], endDirY[Count], endDirZ[Count];
+            f32 time[Count];
+            i32 traversal[Count];
+
+            // Turns cover straight, gentle, sharp, perpendicular and opposite (fallback) bends
+            const f32 turns[] = {0.0f, 0.4f, 1.5707964f, 2.0f, 3.1415927f, -1.0f, -0.2f};
+
+            for (u32 i = 0; i < Count; i++)
+            {
+                const f32 heading = static_cast<f32>(i) * 0.7f;
+                const f32 turn = turns[i % std::size(turns)];
+                const f32 length = 2.0f + static_cast<f32>(i % 5) * 7.5f;
+
+                startX[i] = static_cast<f32>(i) * 3.0f - 20.0f;
+                startY[i] = static_cast<f32>(i) * 1.5f;
+                startZ[i] = static_cast<f32>(i) * 0.25f;
+                startDirX[i] = std::cos(heading);
+                startDirY[i] = std::sin(heading);
+                startDirZ[i] = 0.0f;
+                endDirX[i] = std::cos(heading + turn);
+                endDirY[i] = std::sin(heading + turn);
+                endDirZ[i] = 0.0f;
+                endX[i] = startX[i] + (startDirX[i] + endDirX[i]) * length;
+                endY[i] = startY[i] + (startDirY[i] + endDirY[i]) * length;
+                endZ[i] = startZ[i] + 1.0f;
+                time[i] = static_cast<f32>(i % 11) / 8.0f - 0.125f;  // also exercises the clamp
+                traversal[i] = 500 + static_cast<i32>(i) * 100;
+            }
+
+            f32 coorX[Count], coorY[Count], coorZ[Count], speedX[Count], speedY[Count], speedZ[Count];
+            CalcCurvePoints({startX, startY, startZ, endX, endY, endZ, startDirX, startDirY, startDirZ, endDirX, endDirY,
+                                endDirZ, time, traversal},
+                Count, {coorX, coorY, coorZ, speedX, speedY, speedZ});
+
+            for (u32 i = 0; i < Count; i++)
+            {
+                CVector resultCoor;
+                CVector resultSpeed;
+                CalcCurvePoint(CVector(startX[i], startY[i], startZ[i]), CVector(endX[i], endY[i], endZ[i]),
+                    CVector(startDirX[i], startDirY[i], startDirZ[i]), CVector(endDirX[i], endDirY[i], endDirZ[i]),
+                    time[i], traversal[i], resultCoor, resultSpeed);
+
+                assert(FLOAT_EQUAL(coorX[i], resultCoor.x) && FLOAT_EQUAL(coorY[i], resultCoor.y) &&
+                       FLOAT_EQUAL(coorZ[i], resultCoor.z) && "Test Case 1 Failed: Batch curve point mismatch.");
+                assert(FLOAT_EQUAL(speedX[i], resultSpeed.x) && FLOAT_EQUAL(speedY[i], resultSpeed.y) &&
+                       FLOAT_EQUAL(speedZ[i], resultSpeed.z) && "Test Case 1 Failed: Batch curve speed mismatch.");
+            }
+        }
+    };
+
+    auto CCurveSegment_test = [&]
+    {
+        // Test Case 1: CCurveSegment - Prebuilt evaluation matches CalcCurvePoint
+        for (const CTestCurve& curve : TestCurveSet)
+        {
+            const CCurveSegment segment(curve.startCoors, curve.endCoors, curve.startDir, curve.endDir);
+
+            for (f32 time : {-0.5f, 0.0f, 0.1f, 0.25f, 0.5f, 0.75f, 0.9f, 1.0f, 1.5f})
+            {
+                CVector expectedCoor, expectedSpeed;
+                CalcCurvePoint(curve.startCoors, curve.endCoors, curve.startDir, curve.endDir, time, 1500,
+                    expectedCoor, expectedSpeed);
+
+                CVector resultCoor, resultSpeed;
+                CalcCurvePoint(segment, time, 1500, resultCoor, resultSpeed);
+
+                assert(FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                       FLOAT_EQUAL(resultCoor.z, expectedCoor.z) && "Test Case 1 Failed: Incorrect curve point.");
+                assert(FLOAT_EQUAL(resultSpeed.x, expectedSpeed.x) && FLOAT_EQUAL(resultSpeed.y, expectedSpeed.y) &&
+                       FLOAT_EQUAL(resultSpeed.z, expectedSpeed.z) && "Test Case 1 Failed: Incorrect curve speed.");
+            }
+        }
+
+        // Test Case 2: CCurveSegment - Prebuilt speed scale factor matches CalcSpeedScaleFactor
+        for (const CTestCurve& curve : TestCurveSet)
+        {
+            const CCurveSegment segment(curve.startCoors, curve.endCoors, curve.startDir, curve.endDir);
+            const f32 expected = CalcSpeedScaleFactor(
+                curve.startCoors, curve.endCoors, curve.startDir.x, curve.startDir.y, curve.endDir.x, curve.endDir.y);
+
+            assert(FLOAT_EQUAL(CalcSpeedScaleFactor(segment), expected) &&
+                   "Test Case 2 Failed: Incorrect speed scale factor.");
+        }
+    };
+
+    auto CalcCurveState_test = [&]
+    {
+        // Test Case 1: CalcCurveState - Matches the separate calls
+        for (const CTestCurve& curve : TestCurveSet)
+        {
+            for (f32 time : {0.0f, 0.3f, 0.5f, 0.9f, 1.0f})
+            {
+                CCurveState state;
+                CalcCurveState(curve.startCoors, curve.endCoors, curve.startDir, curve.endDir, time, 1500, state);
+
+                CVector expectedCoor, expectedSpeed;
+                CalcCurvePoint(curve.startCoors, curve.endCoors, curve.startDir, curve.endDir, time, 1500,
+                    expectedCoor, expectedSpeed);
+                const CVector& startDir = curve.startDir;
+                const CVector& endDir = curve.endDir;
+                const f32 speedVariation = CalcSpeedVariationInBend(
+                    curve.startCoors, curve.endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+                const f32 speedScaleFactor =
+                    CalcSpeedScaleFactor(curve.startCoors, curve.endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+
+                assert(FLOAT_EQUAL(state.Coors.x, expectedCoor.x) && FLOAT_EQUAL(state.Coors.y, expectedCoor.y) &&
+                       FLOAT_EQUAL(state.Coors.z, expectedCoor.z) && "Test Case 1 Failed: Incorrect curve point.");
+                assert(FLOAT_EQUAL(state.Speed.x, expectedSpeed.x) && FLOAT_EQUAL(state.Speed.y, expectedSpeed.y) &&
+                       FLOAT_EQUAL(state.Speed.z, expectedSpeed.z) && "Test Case 1 Failed: Incorrect curve speed.");
+                assert(FLOAT_EQUAL(state.SpeedVariation, speedVariation) &&
+                       "Test Case 1 Failed: Incorrect speed variation.");
+                assert(FLOAT_EQUAL(state.SpeedScaleFactor, speedScaleFactor) &&
+                       "Test Case 1 Failed: Incorrect speed scale factor.");
+            }
+        }
+
+        // Test Case 2: CalcCurveState - Total distance of a crossing curve and of the fallback
+        {
+            CCurveState state;
+            CalcCurveState({0.0f, 0.0f, 0.0f}, {20.0f, 20.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f,
+                1000, state);
+            assert(FLOAT_EQUAL(state.TotalDist, 40.0f) && FLOAT_EQUAL(state.SpeedScaleFactor, 40.0f) &&
+                   "Test Case 2 Failed: Incorrect total distance.");
+
+            CalcCurveState({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, 0.5f,
+                1000, state);
+            assert(FLOAT_EQUAL(state.TotalDist, 0.0f) && FLOAT_EQUAL(state.SpeedScaleFactor, 1.5f) &&
+                   "Test Case 2 Failed: Fallback should keep the game's zero distance.");
+        }
+    };
+
+    auto CalcCorrectedDistFast_test = []
+    {
+        // Test Case 1: FastSin/FastCos - Documented error bounds over the CalcCorrectedDist argument ranges
+        {
+            for (u32 i = 0; i <= 100000; i++)
+            {
+                const f32 sinArg = static_cast<f32>(i) * (TWO_PI / 100000.0f);
+                const f32 cosArg = static_cast<f32>(i) * (PI / 100000.0f);
+
+                assert(std::fabs(CMaths::FastSin(sinArg) - std::sin(static_cast<f64>(sinArg))) < 2.2e-7 &&
+                       "Test Case 1 Failed: FastSin error above the documented bound.");
+                assert(std::fabs(CMaths::FastCos(cosArg) - std::cos(static_cast<f64>(cosArg))) < 1.9e-7 &&
+                       "Test Case 1 Failed: FastCos error above the documented bound.");
+            }
+        }
+
+        // Test Case 2: CalcCorrectedDistFast - Matches CalcCorrectedDist across the curve
+        {
+            for (f32 total : {0.2f, 1.0f, 37.5f, 1000.0f})
+            {
+                for (f32 speedVariation : {0.0f, 0.1f, 1.0f / 3.0f})
+                {
+                    for (u32 i = 0; i <= 64; i++)
+                    {
+                        const f32 current = total * static_cast<f32>(i) / 64.0f;
+
+                        f32 interpol = 0.0f, fastInterpol = 0.0f;
+                        const f32 correctedDist = CalcCorrectedDist(current, total, speedVariation, &interpol);
+                        const f32 fastCorrectedDist =
+                            CalcCorrectedDistFast(current, total, speedVariation, &fastInterpol);
+
+                        assert(FLOAT_EQUAL(fastCorrectedDist, correctedDist) && FLOAT_EQUAL(fastInterpol, interpol) &&
+                               "Test Case 2 Failed: Fast corrected distance out of tolerance.");
+                    }
+                }
+            }
+        }
+
+        // Test Case 3: CalcCorrectedDistFast - Degenerate Total Distance
+        {
+            f32 interpol = 0.0f;
+            f32 correctedDist = CalcCorrectedDistFast(0.5f, -1.0f, 0.5f, &interpol);
+
+            assert(FLOAT_EQUAL(correctedDist, 0.0f) && FLOAT_EQUAL(interpol, 0.5f) &&
+                   "Test Case 3 Failed: Corrected distance should handle negative Total distance.");
+        }
+    };
+
+    auto CCurveArcLength_test = [&]
+    {
+        // Test Case 1: CCurveArcLength - Straight line maps distance to the matching point
+        {
+            const CCurveSegment segment({0.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f});
+            const CCurveArcLength arcLength(segment);
+
+            CVector resultCoor, resultSpeed;
+            CalcCurvePoint(segment, arcLength.FindTimeAtDist(3.2f), 1000, resultCoor, resultSpeed);
+
+            assert(FLOAT_EQUAL(arcLength.Length, 10.0f) && FLOAT_EQUAL(resultCoor.x, 3.2f) &&
+                   FLOAT_EQUAL(resultCoor.y, 0.0f) && "Test Case 1 Failed: Incorrect point at distance.");
+            assert(arcLength.FindTimeAtDist(-1.0f) == 0.0f && arcLength.FindTimeAtDist(11.0f) == 1.0f &&
+                   "Test Case 1 Failed: Distance should be clamped to the curve.");
+        }
+
+        // Test Case 2: CCurveArcLength - Equal distance steps cover equal world-space distances
+        {
+            const CCurveSegment segments[] = {
+                {{0.0f, 0.0f, 0.0f}, {20.0f, 20.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                {{0.0f, 0.0f, 0.0f}, {4.0f, 3.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                {{0.0f, 0.0f, 0.0f}, {10.0f, 3.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+            };
+
+            for (const CCurveSegment& segment : segments)
+            {
+                const CCurveArcLength arcLength(segment);
+                constexpr u32 Steps = 64;
+
+                f32 prevTime = arcLength.FindTimeAtDist(0.0f);
+                CVector prevCoor, resultCoor, resultSpeed;
+                CalcCurvePoint(segment, prevTime, 1000, prevCoor, resultSpeed);
+
+                for (u32 i = 1; i <= Steps; i++)
+                {
+                    const f32 dist = arcLength.Length * static_cast<f32>(i) / static_cast<f32>(Steps);
+                    const f32 time = arcLength.FindTimeAtDist(dist);
+                    CalcCurvePoint(segment, time, 1000, resultCoor, resultSpeed);
+
+                    const f32 stepLength = PathStep(segment, prevTime, prevCoor, time, resultCoor);
+                    assert(stepLength == Approx(arcLength.Length / Steps).epsilon(0.05) &&
+                           "Test Case 2 Failed: Uneven world-space step.");
+                    prevTime = time;
+                    prevCoor = resultCoor;
+                }
+            }
+        }
+    };
+
+    auto CCurveCursor_test = []
+    {
+        const CCurveSegment segments[] = {
+            {{0.0f, 0.0f, 0.0f}, {20.0f, 20.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+            {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+            {{0.0f, 0.0f, 0.0f}, {10.0f, 3.0f, 2.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+        };
+
+        // Test Case 1: CCurveCursor - Stepping through the curve matches CalcCurvePoint at every step
+        for (const CCurveSegment& segment : segments)
+        {
+            CCurveCursor cursor(segment, 2000);
+            u32 sectionsSeen = 0;
+
+            while (!cursor.IsFinished())
+            {
+                cursor.Advance(16.6f);
+                sectionsSeen |= 1u << cursor.GetSection();
+
+                CVector resultCoor, resultSpeed;
+                CalcCurvePoint(segment.StartCoors, segment.EndCoors, segment.StartDir, segment.EndDir, cursor.GetTime(),
+                    2000, resultCoor, resultSpeed);
+
+                const CVector& position = cursor.GetPosition();
+                const CVector& speed = cursor.GetSpeed();
+                assert(FLOAT_EQUAL(position.x, resultCoor.x) && FLOAT_EQUAL(position.y, resultCoor.y) &&
+                       FLOAT_EQUAL(position.z, resultCoor.z) && "Test Case 1 Failed: Incorrect cursor position.");
+                assert(FLOAT_EQUAL(speed.x, resultSpeed.x) && FLOAT_EQUAL(speed.y, resultSpeed.y) &&
+                       FLOAT_EQUAL(speed.z, resultSpeed.z) && "Test Case 1 Failed: Incorrect cursor speed.");
+            }
+
+            assert(cursor.GetTime() == 1.0f && "Test Case 1 Failed: Cursor should stop at the end.");
+            assert((segment.bCrossing ? (sectionsSeen & (1u << CCurveCursor::SECTION_BEND)) != 0
+                                      : sectionsSeen == (1u << CCurveCursor::SECTION_FALLBACK)) &&
+                   "Test Case 1 Failed: Cursor skipped a section.");
+        }
+
+        // Test Case 2: CCurveCursor - Jumping back in time picks the right section again
+        {
+            CCurveCursor cursor(segments[0], 2000, 0.9f);
+            assert(cursor.GetSection() == CCurveCursor::SECTION_SECOND_STRAIGHT && "Test Case 2 Failed.");
+
+            cursor.SetTime(0.1f);
+            assert(cursor.GetSection() == CCurveCursor::SECTION_FIRST_STRAIGHT &&
+                   FLOAT_EQUAL(cursor.GetPosition().x, 4.0f) && FLOAT_EQUAL(cursor.GetPosition().y, 0.0f) &&
+                   "Test Case 2 Failed: Incorrect cursor position.");
+        }
+
+        // Test Case 3: CCurveCursor - A negative step goes back a section and stops at the start
+        {
+            CCurveCursor cursor(segments[0], 2000, 0.9f);
+            cursor.Advance(-1000.0f);
+            assert(cursor.GetSection() == CCurveCursor::SECTION_BEND && FLOAT_EQUAL(cursor.GetTime(), 0.4f) &&
+                   "Test Case 3 Failed: Cursor didn't step back.");
+
+            cursor.Advance(-1000.0f);
+            assert(cursor.GetSection() == CCurveCursor::SECTION_FIRST_STRAIGHT && cursor.GetTime() == 0.0f &&
+                   FLOAT_EQUAL(cursor.GetPosition().x, 0.0f) && FLOAT_EQUAL(cursor.GetPosition().y, 0.0f) &&
+                   "Test Case 3 Failed: Cursor should stop at the start.");
+        }
+    };
+
+    auto CCurveThreadPool_test = [&]
+    {
+        CCurveThreadPool pool(4);
+
+        // Test Case 1: CCurveThreadPool - Every chunk runs exactly once, also when there are fewer chunks than threads
+        for (u32 numChunks : {1u, 3u, 4u, 97u, 1000u})
+        {
+            std::vector<std::atomic<u32>> runs(numChunks);
+            for (u32 repeat = 0; repeat < 10; repeat++)
+            {
+                pool.Run(numChunks,
+                    [](void* pContext, u32 Chunk)
+                    {
+                        static_cast<std::atomic<u32>*>(pContext)[Chunk]++;
+                    },
+                    runs.data());
+            }
+
+            for (const std::atomic<u32>& count : runs)
+            {
+                assert(count == 10 && "Test Case 1 Failed: Chunk skipped or run twice.");
+            }
+        }
+
+        // Test Case 2: CCurveThreadPool - CalcCurvePoints matches the serial batch, partial last chunk included
+        {
+            constexpr u32 Count = CCurveThreadPool::CURVES_PER_CHUNK * 13 + 37;
+            std::vector<f32> in[13], out[6], expected[6];
+            std::vector<i32> traversal(Count);
+            for (std::vector<f32>& v : in)
+            {
+                v.resize(Count);
+            }
+            for (u32 k = 0; k < 6; k++)
+            {
+                out[k].resize(Count);
+                expected[k].resize(Count);
+            }
+
+            const std::vector<CCurveSegment> segments =
+                ScatteredSegments(Count, CVector(150.0f, 150.0f, 1.0f), 300, 2.0f, 7.5f, 0.02f);
+            for (u32 i = 0; i < Count; i++)
+            {
+                const CCurveSegment& segment = segments[i];
+                const CVector* vectors[4] = {
+                    &segment.StartCoors, &segment.EndCoors, &segment.StartDir, &segment.EndDir};
+                for (u32 v = 0; v < 4; v++)
+                {
+                    in[v * 3][i] = vectors[v]->x;
+                    in[v * 3 + 1][i] = vectors[v]->y;
+                    in[v * 3 + 2][i] = vectors[v]->z;
+                }
+                in[12][i] = static_cast<f32>(i % 11) / 10.0f;
+                traversal[i] = 1000;
+            }
+
+            const CCurveBatch batch = {in[0].data(), in[1].data(), in[2].data(), in[3].data(), in[4].data(),
+                in[5].data(), in[6].data(), in[7].data(), in[8].data(), in[9].data(), in[10].data(), in[11].data(),
+                in[12].data(), traversal.data()};
+            CalcCurvePoints(batch, Count,
+                {expected[0].data(), expected[1].data(), expected[2].data(), expected[3].data(), expected[4].data(),
+                    expected[5].data()});
+            pool.CalcCurvePoints(batch, Count,
+                {out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data(), out[5].data()});
+
+            for (u32 k = 0; k < 6; k++)
+            {
+                for (u32 i = 0; i < Count; i++)
+                {
+                    assert(FLOAT_EQUAL(out[k][i], expected[k][i]) && "Test Case 2 Failed: Parallel batch mismatch.");
+                }
+            }
+        }
+    };
+
+    auto CVectorSimd_test = []
+    {
+        // Test Case 1: CVectorSimd - Round trip through CVector keeps the components and zeroes the padding
+        {
+            const CVector vec(1.5f, -2.0f, 3.25f);
+            const CVectorSimd simd = vec;
+            const CVector back = simd;
+
+            assert(simd.x == 1.5f && simd.y == -2.0f && simd.z == 3.25f && simd.w == 0.0f &&
+                   "Test Case 1 Failed: Incorrect conversion from CVector.");
+            assert(back.x == vec.x && back.y == vec.y && back.z == vec.z &&
+                   "Test Case 1 Failed: Incorrect conversion to CVector.");
+        }
+
+        // Test Case 2: CVectorSimd - Packed arithmetic matches CVector's
+        {
+            const CVector a(1.0f, 2.0f, 3.0f);
+            const CVector b(-4.0f, 0.5f, 8.0f);
+            const CVector expected = (a + b * 2.0f) - a * 0.25f;
+            const CVector result = (CVectorSimd(a) + CVectorSimd(b) * 2.0f) - CVectorSimd(a) * 0.25f;
+
+            assert(FLOAT_EQUAL(result.x, expected.x) && FLOAT_EQUAL(result.y, expected.y) &&
+                   FLOAT_EQUAL(result.z, expected.z) && "Test Case 2 Failed: Incorrect packed arithmetic.");
+            assert(FLOAT_EQUAL(CVectorSimd(b).Magnitude2D(), b.Magnitude2D()) &&
+                   FLOAT_EQUAL(CVectorSimd(b).Magnitude(), b.Magnitude()) &&
+                   FLOAT_EQUAL(CVectorSimd(a).Dot(CVectorSimd(b)), 21.0f) &&
+                   "Test Case 2 Failed: Incorrect magnitude.");
+        }
+
+        // Test Case 3: CVectorSimd - Usable in constant expressions
+        static_assert((CVectorSimd(1.0f, 2.0f, 3.0f) - CVectorSimd(1.0f, 0.0f, -1.0f)).Dot(
+                          CVectorSimd(1.0f, 1.0f, 1.0f)) == 6.0f &&
+                      "Test Case 3 Failed: Incorrect constexpr arithmetic.");
+    };
+
+    auto FindClosestTime_test = []
+    {
+        // lane change, 90 degree turn, u-turn, near-straight and two fallbacks (diverging and parallel rays)
+        const CCurveSegment segments[] = {
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(30.0f, 4.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f)),
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(20.0f, 20.0f, 2.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f)),
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(0.0f, 8.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(-1.0f, 0.0f, 0.0f)),
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(50.0f, 1.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(0.9998f, 0.02f, 0.0f)),
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(10.0f, 10.0f, 0.0f), CVector(0.0f, -1.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f)),
+            CCurveSegment(CVector(0.0f, 0.0f, 0.0f), CVector(10.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f)),
+        };
+
+        for (const CCurveSegment& segment : segments)
+        {
+            // Test Case 1: FindClosestTime - Points on the curve are found at (nearly) zero distance
+            for (u32 i = 0; i <= 20; i++)
+            {
+                CVector onCurve, resultSpeed, closest;
+                CalcCurvePoint(segment, static_cast<f32>(i) / 20.0f, 1000, onCurve, resultSpeed);
+                FindClosestTime(segment, onCurve, closest);
+
+                assert((closest - onCurve).Magnitude() < 0.01f && "Test Case 1 Failed: Point on the curve missed.");
+            }
+
+            // Test Case 2: FindClosestTime - Never further than the best of a dense sampling, result on the curve
+            for (u32 q = 0; q < 100; q++)
+            {
+                const CVector point(static_cast<f32>((q * 37) % 70) - 25.0f, static_cast<f32>((q * 53) % 60) - 25.0f,
+                    static_cast<f32>(q % 3));
+
+                f32 bruteDist = 3.4e38f;
+                for (u32 i = 0; i <= 4096; i++)
+                {
+                    CVector resultCoor, resultSpeed;
+                    CalcCurvePoint(segment, static_cast<f32>(i) / 4096.0f, 1000, resultCoor, resultSpeed);
+                    bruteDist = std::min(bruteDist, (resultCoor - point).Magnitude());
+                }
+
+                CVector closest, resultCoor, resultSpeed;
+                const f32 Time = FindClosestTime(segment, point, closest);
+                CalcCurvePoint(segment, Time, 1000, resultCoor, resultSpeed);
+
+                assert(Time >= 0.0f && Time <= 1.0f && "Test Case 2 Failed: Time out of range.");
+                assert((closest - point).Magnitude() <= bruteDist + 0.01f &&
+                       "Test Case 2 Failed: Closest point further than dense sampling.");
+                assert(closest.x == resultCoor.x && closest.y == resultCoor.y && closest.z == resultCoor.z &&
+                       "Test Case 2 Failed: Closest point differs from CalcCurvePoint.");
+            }
+        }
+    };
+
+    auto CCurveRoute_test = []
+    {
+        // a chain of lane changes, bends and one fallback, each curve starting where the previous one ends
+        std::vector<CCurveSegment> segments;
+        std::vector<i32> traversals;
+        CVector coors(0.0f, 0.0f, 0.0f);
+        f32 heading = 0.0f;
+        for (u32 i = 0; i < 12; i++)
+        {
+            const f32 turn = i == 7 ? 3.0f : static_cast<f32>(i % 5) * 0.35f - 0.7f;
+            const f32 length = 6.0f + static_cast<f32>(i % 4) * 9.0f;
+            const CVector startDir(std::cos(heading), std::sin(heading), 0.0f);
+            const CVector endDir(std::cos(heading + turn), std::sin(heading + turn), 0.0f);
+            const CVector endCoors = coors + CVector(std::cos(heading + turn * 0.5f), std::sin(heading + turn * 0.5f),
+                                                 0.05f) * length;
+            segments.emplace_back(coors, endCoors, startDir, endDir);
+            traversals.push_back(500 + static_cast<i32>(i) * 100);
+            coors = endCoors;
+            heading += turn;
+        }
+
+        CCurveRoute route;
+        for (u32 i = 0; i < segments.size(); i++)
+        {
+            route.PushBack(segments[i], traversals[i]);
+        }
+
+        // Test Case 1: CCurveRoute - Matches walking the curves and summing CalcSpeedScaleFactor
+        {
+            f32 startDist = 0.0f;
+            i32 startTime = 0;
+            for (u32 i = 0; i < segments.size(); i++)
+            {
+                const f32 length = CalcSpeedScaleFactor(segments[i]);
+                assert(FLOAT_EQUAL(route.GetCurveStartDist(i), startDist) &&
+                       "Test Case 1 Failed: Incorrect start distance.");
+
+                for (f32 Time : {0.1f, 0.5f, 0.9f})
+                {
+                    CVector expectedCoor, expectedSpeed, resultCoor, resultSpeed;
+                    CalcCurvePoint(segments[i], Time, traversals[i], expectedCoor, expectedSpeed);
+
+                    assert(route.CalcPointAtDist(startDist + length * Time, resultCoor, resultSpeed) == i &&
+                           FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                           FLOAT_EQUAL(resultSpeed.x, expectedSpeed.x) &&
+                           "Test Case 1 Failed: Incorrect point at distance.");
+                    assert(route.CalcPointAtTime(static_cast<f32>(startTime) + traversals[i] * Time, resultCoor,
+                               resultSpeed) == i &&
+                           FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                           FLOAT_EQUAL(resultSpeed.y, expectedSpeed.y) &&
+                           "Test Case 1 Failed: Incorrect point at time.");
+                }
+
+                startDist += length;
+                startTime += traversals[i];
+            }
+
+            assert(FLOAT_EQUAL(route.GetLength(), startDist) &&
+                   FLOAT_EQUAL(route.GetTraverselTimeInMillis(), static_cast<f32>(startTime)) &&
+                   "Test Case 1 Failed: Incorrect route totals.");
+        }
+
+        // Test Case 2: CCurveRoute - Curve boundaries and out of range distances
+        {
+            CVector resultCoor, resultSpeed;
+            route.CalcPointAtDist(route.GetCurveStartDist(5), resultCoor, resultSpeed);
+            assert(FLOAT_EQUAL(resultCoor.x, segments[5].StartCoors.x) &&
+                   FLOAT_EQUAL(resultCoor.y, segments[5].StartCoors.y) &&
+                   "Test Case 2 Failed: Boundary not on the start of the next curve.");
+
+            f32 Time = -1.0f;
+            assert(route.FindCurveAtDist(-10.0f, &Time) == 0 && Time == 0.0f &&
+                   "Test Case 2 Failed: Distance before the route not clamped.");
+            assert(route.FindCurveAtDist(route.GetLength() + 10.0f, &Time) == route.GetNumCurves() - 1 &&
+                   Time == 1.0f && "Test Case 2 Failed: Distance past the route not clamped.");
+        }
+
+        // Test Case 3: CCurveRoute - Popping and pushing at both ends shifts the route without changing the curves
+        {
+            const f32 firstLength = route.GetCurveStartDist(1);
+            const f32 dist = route.GetCurveStartDist(6) + 2.0f;
+            CVector expectedCoor, expectedSpeed, resultCoor, resultSpeed;
+            route.CalcPointAtDist(dist, expectedCoor, expectedSpeed);
+
+            route.PopFront();
+            route.PopBack();
+            assert(route.GetNumCurves() == segments.size() - 2 && "Test Case 3 Failed: Incorrect curve count.");
+            assert(route.CalcPointAtDist(dist - firstLength, resultCoor, resultSpeed) == 5 &&
+                   FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                   "Test Case 3 Failed: Incorrect point after popping.");
+
+            route.PushFront(segments.front(), traversals.front());
+            route.PushBack(segments.back(), traversals.back());
+            assert(route.CalcPointAtDist(dist, resultCoor, resultSpeed) == 6 &&
+                   FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                   "Test Case 3 Failed: Incorrect point after pushing back.");
+
+            // slide the whole route forward, past where the first curve used to start
+            for (u32 i = 0; i < segments.size(); i++)
+            {
+                route.PopFront();
+                route.PushBack(segments[i], traversals[i]);
+            }
+            const f32 lastStartDist = route.GetCurveStartDist(11);
+            assert(FLOAT_EQUAL(route.GetLength(), lastStartDist + CalcSpeedScaleFactor(segments.back())) &&
+                   route.CalcPointAtDist(dist, resultCoor, resultSpeed) == 6 &&
+                   FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                   "Test Case 3 Failed: Incorrect point after sliding the route.");
+        }
+    };
+
+    auto CalcCurveLength_test = [&]
+    {
+        // Chord length of CalcCurvePoint at fine Time steps
+        const auto SampledLength = [&](const CCurveSegment& segment)
+        {
+            f64 length = 0.0;
+            CVector prevCoor, resultCoor, resultSpeed;
+            CalcCurvePoint(segment, 0.0f, 1000, prevCoor, resultSpeed);
+            for (u32 i = 1; i <= 20000; i++)
+            {
+                const f32 time = static_cast<f32>(i) / 20000.0f;
+                CalcCurvePoint(segment, time, 1000, resultCoor, resultSpeed);
+                length += PathStep(segment, static_cast<f32>(i - 1) / 20000.0f, prevCoor, time, resultCoor);
+                prevCoor = resultCoor;
+            }
+            return static_cast<f32>(length);
+        };
+
+        // Test Case 1: CalcCurveLength - Straight road, same direction at both ends
+        {
+            f32 length = 0.0f;
+            CalcCurveLength(CVector(0.0f, 0.0f, 0.0f), CVector(0.0f, 10.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f), &length);
+            assert(FLOAT_EQUAL(length, 10.0f) && "Test Case 1 Failed: Expected the straight-line distance.");
+        }
+
+        // Test Case 2: CalcCurveLength - 90 degree turn, two straights and the bend
+        {
+            const CCurveSegment segment(CVector(0.0f, 0.0f, 0.0f), CVector(20.0f, 20.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+            assert(segment.bCrossing && FLOAT_EQUAL(CalcCurveLength(segment), SampledLength(segment)) &&
+                   "Test Case 2 Failed: Incorrect length of a bend.");
+        }
+
+        // Test Case 3: CalcCurveLength - Crossing and fallback curves against the sampled length, batched included
+        {
+            const std::vector<CCurveSegment> segments =
+                ScatteredSegments(60, CVector(5.0f, -3.0f, 1.0f), 0, 3.0f, 11.0f, 0.05f);
+
+            std::vector<f32> lengths(segments.size());
+            CalcCurveLengths(segments.data(), static_cast<u32>(segments.size()), lengths.data());
+
+            for (u32 i = 0; i < segments.size(); i++)
+            {
+                const CCurveSegment& segment = segments[i];
+                f32 length = 0.0f;
+                CalcCurveLength(segment.StartCoors, segment.EndCoors, segment.StartDir, segment.EndDir, &length);
+
+                assert(length == CalcCurveLength(segment) && lengths[i] == length &&
+                       "Test Case 3 Failed: Overloads disagree.");
+                assert(std::fabs(length - SampledLength(segment)) <= 1e-3f * length + 1e-3f &&
+                       "Test Case 3 Failed: Incorrect length.");
+            }
+        }
+    };
+
+    auto CalcCurvePointBranchless_test = [&]
+    {
+        // Test Case 1: CalcCurvePointBranchless - Bit-identical to CalcCurvePoint on crossing and fallback curves,
+        // every section, clamped times, a parallel pair and a zero-length curve
+        {
+            std::vector<std::array<CVector, 4>> curves;
+            const std::vector<CCurveSegment> segments =
+                ScatteredSegments(60, CVector(5.0f, -3.0f, 1.0f), 0, 3.0f, 11.0f, 0.05f);
+            for (const CCurveSegment& segment : segments)
+            {
+                curves.push_back({segment.StartCoors, segment.EndCoors, segment.StartDir, segment.EndDir});
+            }
+            curves.push_back({CVector(0.0f, 0.0f, 0.0f), CVector(0.0f, 10.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(-1.0f, 0.0f, 0.0f)});
+            curves.push_back({CVector(3.0f, 4.0f, 0.0f), CVector(3.0f, 4.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f)});
+
+            for (const auto& curve : curves)
+            {
+                for (f32 Time = -0.1f; Time <= 1.1f; Time += 0.01f)
+                {
+                    CVector expectedCoor, expectedSpeed, resultCoor, resultSpeed;
+                    CCurveMath::CalcCurvePoint(
+                        curve[0], curve[1], curve[2], curve[3], Time, 1500, expectedCoor, expectedSpeed);
+                    CCurveMath::CalcCurvePointBranchless(
+                        curve[0], curve[1], curve[2], curve[3], Time, 1500, resultCoor, resultSpeed);
+
+                    assert(std::memcmp(&resultCoor, &expectedCoor, sizeof(CVector)) == 0 &&
+                           std::memcmp(&resultSpeed, &expectedSpeed, sizeof(CVector)) == 0 &&
+                           "Test Case 1 Failed: Differs from CalcCurvePoint.");
+
+                    // CCurves' one may use the CCurveFast policy, or be compared against the game
+                    CalcCurvePoint(curve[0], curve[1], curve[2], curve[3], Time, 1500, expectedCoor, expectedSpeed);
+                    CalcCurvePointBranchless(
+                        curve[0], curve[1], curve[2], curve[3], Time, 1500, resultCoor, resultSpeed);
+
+                    assert(FLOAT_EQUAL(resultCoor.x, expectedCoor.x) && FLOAT_EQUAL(resultCoor.y, expectedCoor.y) &&
+                           FLOAT_EQUAL(resultCoor.z, expectedCoor.z) && FLOAT_EQUAL(resultSpeed.x, expectedSpeed.x) &&
+                           FLOAT_EQUAL(resultSpeed.y, expectedSpeed.y) && "Test Case 1 Failed: Incorrect point.");
+                }
+            }
+        }
+
+        // Test Case 2: CalcCurvePointBranchless - Usable in constant expressions
+        static_assert(
+            []
+            {
+                CVector resultCoor, resultSpeed;
+                CCurveMath::CalcCurvePointBranchless(CVector(0.0f, 0.0f, 0.0f), CVector(20.0f, 20.0f, 0.0f),
+                    CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f), 0.5f, 1000, resultCoor, resultSpeed);
+                return FLOAT_EQUAL(resultCoor.x, 18.75f) && FLOAT_EQUAL(resultCoor.y, 1.25f);
+            }() &&
+            "Test Case 2 Failed: Incorrect point.");
+    };
+
+    auto CalcCurvePolyline_test = [&]
+    {
+        // Every chord within the tolerance of CalcCurvePoint at fine Time steps between its ends
+        const auto CheckPolyline = [](const CCurveSegment& segment, f32 Tolerance, const char* pMessage)
+        {
+            CVector points[1024];
+            f32 times[1024];
+            const u32 numPoints = CalcCurvePolyline(segment, Tolerance, points, times, 1024);
+            assert(numPoints >= 2 && numPoints <= 1024 && pMessage);
+            assert(times[0] == 0.0f && times[numPoints - 1] == 1.0f && pMessage);
+
+            CVector resultCoor, resultSpeed;
+            for (u32 i = 0; i < numPoints; i++)
+            {
+                CalcCurvePoint(segment, times[i], 1000, resultCoor, resultSpeed);
+                assert((resultCoor - points[i]).Magnitude() < 1e-3f && (i == 0 || times[i] > times[i - 1]) &&
+                       pMessage);
+            }
+
+            u32 chord = 0;
+            for (u32 i = 0; i <= 4000; i++)
+            {
+                const f32 Time = static_cast<f32>(i) / 4000.0f;
+                while (chord + 2 < numPoints && times[chord + 1] < Time)
+                {
+                    chord++;
+                }
+                CalcCurvePoint(segment, Time, 1000, resultCoor, resultSpeed);
+
+                const CVector a = points[chord];
+                const CVector ab = points[chord + 1] - a;
+                const f32 abSqr = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+                const CVector offset = resultCoor - a;
+                const f32 t = abSqr > 0.0f ? (offset.x * ab.x + offset.y * ab.y + offset.z * ab.z) / abSqr : 0.0f;
+                const f32 dist = (offset - ab * std::clamp(t, 0.0f, 1.0f)).Magnitude();
+                assert(dist <= Tolerance * 1.01f + 1e-4f && pMessage);
+            }
+            return numPoints;
+        };
+
+        // Test Case 1: CalcCurvePolyline - Straight road is its two ends
+        {
+            const CCurveSegment segment(CVector(0.0f, 0.0f, 0.0f), CVector(0.0f, 50.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+            assert(CheckPolyline(segment, 0.01f, "Test Case 1 Failed: Chord off the curve.") == 2 &&
+                   "Test Case 1 Failed: Expected only the ends.");
+        }
+
+        // Test Case 2: CalcCurvePolyline - 90 degree turn, points only in the bend and more for a finer tolerance
+        {
+            const CCurveSegment segment(CVector(0.0f, 0.0f, 0.0f), CVector(60.0f, 60.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+            const u32 coarse = CheckPolyline(segment, 0.1f, "Test Case 2 Failed: Chord off the curve.");
+            const u32 fine = CheckPolyline(segment, 0.001f, "Test Case 2 Failed: Chord off the curve.");
+            assert(coarse >= 5 && coarse < 10 && fine > coarse && "Test Case 2 Failed: Incorrect number of points.");
+
+            CVector points[16];
+            f32 times[16];
+            CalcCurvePolyline(segment, 0.1f, points, times, 16);
+            assert(times[1] == Approx(55.0f / segment.TotalDist_Time) && FLOAT_EQUAL(points[1].x, 55.0f) &&
+                   FLOAT_EQUAL(points[1].y, 0.0f) && "Test Case 2 Failed: Expected a point where the bend starts.");
+        }
+
+        // Test Case 3: CalcCurvePolyline - Crossing and fallback curves stay within the tolerance
+        for (const CCurveSegment& segment : ScatteredSegments(60, CVector(10.0f, -20.0f, 5.0f), 0, 3.0f, 11.0f, 0.05f))
+        {
+            CheckPolyline(segment, 0.05f, "Test Case 3 Failed: Chord off the curve.");
+        }
+
+        // Test Case 4: CalcCurvePolyline - Counts without writing, and writes no more than fit
+        {
+            const CCurveSegment segment(CVector(0.0f, 0.0f, 0.0f), CVector(20.0f, 20.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+            const u32 numPoints = CalcCurvePolyline(segment, 0.01f, nullptr, nullptr, 0);
+
+            CVector points[8];
+            f32 times[8] = {-1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
+            assert(numPoints > 4 && CalcCurvePolyline(segment, 0.01f, points, times, 4) == numPoints &&
+                   times[3] > 0.0f && times[4] == -1.0f && "Test Case 4 Failed: Wrote past MaxPoints.");
+        }
+    };
+
+    auto CCompactCurve_test = [&]
+    {
+        const CVector origin(-1024.0f, 512.0f, 0.0f);
+
+        // Test Case 1: CCompactCurve - Coordinates on the path node grid round-trip exactly, others within 1/16 unit
+        {
+            const CVector startCoors(-1024.0f + 3000.125f, 512.0f - 2000.5f, 17.375f);
+            const CVector endCoors(1.03f, -7.91f, -3.33f);
+            const CCompactCurve curve(
+                origin, startCoors, endCoors, CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, -1.0f, 0.0f));
+
+            CVector decodedStart, decodedEnd, decodedStartDir, decodedEndDir;
+            curve.Decode(origin, decodedStart, decodedEnd, decodedStartDir, decodedEndDir);
+            assert(decodedStart.x == startCoors.x && decodedStart.y == startCoors.y && decodedStart.z == startCoors.z &&
+                   "Test Case 1 Failed: Grid coordinates changed.");
+            assert(std::fabs(decodedEnd.x - endCoors.x) <= 1.0f / 16.0f &&
+                   std::fabs(decodedEnd.y - endCoors.y) <= 1.0f / 16.0f &&
+                   std::fabs(decodedEnd.z - endCoors.z) <= 1.0f / 16.0f && "Test Case 1 Failed: Coordinates too far.");
+            assert(decodedStartDir.x == 1.0f && decodedStartDir.y == 0.0f && decodedStartDir.z == 0.0f &&
+                   decodedEndDir.x == 0.0f && decodedEndDir.y == -1.0f && decodedEndDir.z == 0.0f &&
+                   "Test Case 1 Failed: Axis directions changed.");
+        }
+
+        // Test Case 2: CCompactCurve - Directions all around the sphere come back unit length within 5e-5 rad
+        {
+            for (u32 i = 0; i < 2000; i++)
+            {
+                // Fibonacci sphere, non-unit on purpose
+                const f32 z = 1.0f - (static_cast<f32>(i) + 0.5f) / 1000.0f;
+                const f32 r = std::sqrt(1.0f - z * z);
+                const f32 angle = static_cast<f32>(i) * 2.39996323f;
+                const CVector dir = CVector(r * std::cos(angle), r * std::sin(angle), z) * 2.5f;
+
+                const CCompactCurve curve(origin, origin, origin, dir, dir * -1.0f);
+                CVector startCoors, endCoors, startDir, endDir;
+                curve.Decode(origin, startCoors, endCoors, startDir, endDir);
+
+                for (const auto& [decoded, expected] : {std::pair(startDir, dir), std::pair(endDir, dir * -1.0f)})
+                {
+                    const CVector cross(decoded.y * expected.z - decoded.z * expected.y,
+                        decoded.z * expected.x - decoded.x * expected.z,
+                        decoded.x * expected.y - decoded.y * expected.x);
+                    const f32 dot = decoded.x * expected.x + decoded.y * expected.y + decoded.z * expected.z;
+                    assert(std::atan2(cross.Magnitude(), dot) <= 5e-5f &&
+                           std::fabs(decoded.Magnitude() - 1.0f) <= 1e-6f && "Test Case 2 Failed: Direction too far.");
+                }
+            }
+        }
+
+        // Test Case 3: CCompactCurve - Range and clamping
+        {
+            assert(CCompactCurve::IsInRange(origin, origin + CVector(CCompactCurve::MAX_OFFSET, -4000.0f, 0.0f)) &&
+                   !CCompactCurve::IsInRange(origin, origin + CVector(0.0f, 0.0f, -4100.0f)) &&
+                   "Test Case 3 Failed: Incorrect range.");
+
+            const CCompactCurve curve(origin, origin + CVector(5000.0f, -5000.0f, 0.0f), origin,
+                CVector(1.0f, 0.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f));
+            CVector startCoors, endCoors, startDir, endDir;
+            curve.Decode(origin, startCoors, endCoors, startDir, endDir);
+            assert(startCoors.x == origin.x + CCompactCurve::MAX_OFFSET &&
+                   startCoors.y == origin.y - CCompactCurve::MAX_OFFSET && "Test Case 3 Failed: Not clamped.");
+        }
+
+        // Test Case 4: CCompactCurve - The math runs on the decoded curve, batched over more than one decode block
+        {
+            constexpr u32 Count = 300;
+            const std::vector<CCurveSegment> segments =
+                ScatteredSegments(Count, CVector(-400.0f, 250.0f, 4.0f), 2000, 40.0f, 0.0f, 0.0f);
+            std::vector<CCompactCurve> curves;
+            std::vector<f32> times;
+            std::vector<i32> traversals;
+            for (u32 i = 0; i < Count; i++)
+            {
+                const CCurveSegment& segment = segments[i];
+                curves.emplace_back(origin, segment.StartCoors, segment.EndCoors, segment.StartDir, segment.EndDir);
+                times.push_back(static_cast<f32>(i % 11) / 10.0f);
+                traversals.push_back(800 + static_cast<i32>(i));
+            }
+
+            std::vector<f32> results[6];
+            for (std::vector<f32>& column : results)
+            {
+                column.resize(Count);
+            }
+            CCompactCurve::CalcCurvePoints(origin, curves.data(), times.data(), traversals.data(), Count,
+                {results[0].data(), results[1].data(), results[2].data(), results[3].data(), results[4].data(),
+                    results[5].data()});
+
+            for (u32 i = 0; i < Count; i++)
+            {
+                CVector startCoors, endCoors, startDir, endDir;
+                curves[i].Decode(origin, startCoors, endCoors, startDir, endDir);
+
+                CVector expectedCoor, expectedSpeed, resultCoor, resultSpeed;
+                CalcCurvePoint(
+                    startCoors, endCoors, startDir, endDir, times[i], traversals[i], expectedCoor, expectedSpeed);
+                curves[i].CalcCurvePoint(origin, times[i], traversals[i], resultCoor, resultSpeed);
+                assert(resultCoor.x == expectedCoor.x && resultCoor.y == expectedCoor.y &&
+                       resultSpeed.x == expectedSpeed.x && "Test Case 4 Failed: Incorrect point.");
+                assert(FLOAT_EQUAL(results[0][i], expectedCoor.x) && FLOAT_EQUAL(results[1][i], expectedCoor.y) &&
+                       FLOAT_EQUAL(results[2][i], expectedCoor.z) && FLOAT_EQUAL(results[3][i], expectedSpeed.x) &&
+                       FLOAT_EQUAL(results[4][i], expectedSpeed.y) && "Test Case 4 Failed: Incorrect batched point.");
+
+                assert(curves[i].CalcSpeedScaleFactor(origin) ==
+                           CalcSpeedScaleFactor(startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y) &&
+                       curves[i].ToSegment(origin).TotalDist_Time ==
+                           CCurveSegment(startCoors, endCoors, startDir, endDir).TotalDist_Time &&
+                       "Test Case 4 Failed: Incorrect speed scale factor.");
+            }
+        }
+    };
+
+    auto CCurveCorpus_test = []
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "curves_corpus_test.bin").string();
+
+        // Test Case 1: CCurveCorpus - Written corpus maps back and matches the implementation that wrote it
+        {
+            assert(CCurveCorpus::Write(path.c_str(), 5000, 42) && "Test Case 1 Failed: Can't write the corpus.");
+
+            CCurveCorpus corpus;
+            assert(corpus.Open(path.c_str()) && corpus.GetHeader().Seed == 42 &&
+                   "Test Case 1 Failed: Can't open the corpus.");
+
+            for (u32 f = 0; f < CCurveCorpus::NUM_FUNCTIONS; f++)
+            {
+                const CCurveCorpus::eFunction function = static_cast<CCurveCorpus::eFunction>(f);
+                const CCurveCorpus::CVerifyResult result = corpus.Verify(function, 0, corpus.GetNumRecords(function));
+                assert(corpus.GetNumRecords(function) == 5000 && result.NumMismatches == 0 &&
+                       result.FirstMismatch == 5000 && "Test Case 1 Failed: Mismatch against the writer.");
+            }
+
+            const auto* pRecords = static_cast<const CCurveCorpus::CCurvePointRecord*>(
+                corpus.GetRecords(CCurveCorpus::CALC_CURVE_POINT));
+            CVector resultCoor, resultSpeed;
+            CalcCurvePoint(pRecords[123].StartCoors, pRecords[123].EndCoors, pRecords[123].StartDir,
+                pRecords[123].EndDir, pRecords[123].Time, pRecords[123].TraverselTimeInMillis, resultCoor, resultSpeed);
+            assert(FLOAT_EQUAL(resultCoor.x, pRecords[123].ResultCoor.x) &&
+                   FLOAT_EQUAL(resultCoor.y, pRecords[123].ResultCoor.y) && "Test Case 1 Failed: Incorrect record.");
+        }
+
+        // Test Case 2: CCurveCorpus - Truncated file is refused
+        {
+            std::filesystem::resize_file(path, 4096);
+
+            CCurveCorpus corpus;
+            assert(!corpus.Open(path.c_str()) && !corpus.IsOpen() && "Test Case 2 Failed: Opened a truncated corpus.");
+        }
+
+        std::filesystem::remove(path);
+    };
+
+    auto CCurveNetwork_test = []
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "curves_network_test.bin").string();
+
+        // Test Case 1: CCurveNetwork - Synthetic node file loads with a curve and length per link
+        {
+            assert(CCurveNetwork::WriteSyntheticNodeFile(path.c_str(), 150 * 150, 7) &&
+                   "Test Case 1 Failed: Can't write the node file.");
+
+            CCurveNetwork network;
+            assert(network.Load(path.c_str()) && network.GetNumNodes() == 150 * 150 &&
+                   network.GetNumLinks() == 2 * 150 * 149 && "Test Case 1 Failed: Can't load the node file.");
+
+            for (u32 i = 0; i < network.GetNumLinks(); i += 37)
+            {
+                const CCurveNetwork::CLink& link = network.GetLink(i);
+                const CCurveSegment segment(network.GetNode(link.StartNode), network.GetNode(link.EndNode),
+                    CVector(link.StartDirX, link.StartDirY, 0.0f), CVector(link.EndDirX, link.EndDirY, 0.0f));
+                const CCurveSegment& curve = network.GetCurve(i);
+                assert(curve.bCrossing == segment.bCrossing && curve.SpeedVariation == segment.SpeedVariation &&
+                       curve.DistToPoint1 == segment.DistToPoint1 && curve.BendDist == segment.BendDist &&
+                       curve.TotalDist_Time == segment.TotalDist_Time && "Test Case 1 Failed: Incorrect curve.");
+                assert(network.GetLength(i) == CalcCurveLength(segment) && "Test Case 1 Failed: Incorrect length.");
+            }
+        }
+
+        // Test Case 2: CCurveNetwork - Loading on a pool builds the same curves as loading serially
+        {
+            CCurveNetwork serial, parallel;
+            CCurveThreadPool pool(3);
+            assert(serial.Load(path.c_str()) && parallel.Load(path.c_str(), &pool) &&
+                   "Test Case 2 Failed: Can't load the node file.");
+            assert(std::memcmp(serial.GetLengths(), parallel.GetLengths(), serial.GetNumLinks() * sizeof(f32)) == 0 &&
+                   "Test Case 2 Failed: Lengths differ.");
+        }
+
+        // Test Case 3: CCurveNetwork - Link to a node the file doesn't have is refused
+        {
+            FILE* pFile = std::fopen(path.c_str(), "r+b");
+            CCurveNetwork::CHeader header;
+            assert(pFile && std::fread(&header, sizeof(header), 1, pFile) == 1 &&
+                   "Test Case 3 Failed: Can't read the header.");
+            std::fseek(pFile, static_cast<long>(header.LinksOffset + 1000 * sizeof(CCurveNetwork::CLink)), SEEK_SET);
+            std::fwrite(&header.NumNodes, sizeof(u32), 1, pFile);
+            std::fclose(pFile);
+
+            CCurveNetwork network;
+            assert(!network.Load(path.c_str()) && !network.IsLoaded() && network.GetNumNodes() == 0 &&
+                   network.GetNumLinks() == 0 && "Test Case 3 Failed: Loaded a link to a missing node.");
+        }
+
+        // Test Case 4: CCurveNetwork - Truncated file is refused
+        {
+            assert(CCurveNetwork::WriteSyntheticNodeFile(path.c_str(), 1000, 7) &&
+                   "Test Case 4 Failed: Can't write the node file.");
+            std::filesystem::resize_file(path, 4096);
+
+            CCurveNetwork network;
+            assert(!network.Load(path.c_str()) && !network.IsLoaded() &&
+                   "Test Case 4 Failed: Loaded a truncated node file.");
+        }
+
+        std::filesystem::remove(path);
+    };
+
+    auto CCurveBVH_test = [&]
+    {
+        const std::vector<CCurveSegment> segments =
+            ScatteredSegments(400, CVector(0.0f, 0.0f, 0.0f), 1000, 5.0f, 10.0f, 0.1f);
+
+        const auto CheckQueries = [](const CCurveBVH& bvh)
+        {
+            for (u32 q = 0; q < 200; q++)
+            {
+                const CVector point(static_cast<f32>((q * 53) % 1100) - 550.0f,
+                    static_cast<f32>((q * 71) % 1100) - 550.0f, static_cast<f32>(q % 5));
+
+                f32 bruteDist = 3.4e38f;
+                u32 bruteInRadius = 0;
+                for (u32 i = 0; i < bvh.GetNumCurves(); i++)
+                {
+                    const f32 dist = CCurveBVH::DistToCurve(bvh.GetCurve(i), point);
+                    bruteDist = std::min(bruteDist, dist);
+                    bruteInRadius += dist <= 40.0f;
+                }
+
+                f32 dist = 0.0f;
+                const i32 nearest = bvh.FindNearest(point, 1e6f, &dist);
+                assert(nearest >= 0 && dist == bruteDist &&
+                       dist == CCurveBVH::DistToCurve(bvh.GetCurve(nearest), point) &&
+                       "Test Case 2 Failed: Nearest curve differs from brute force.");
+
+                u32 indices[64];
+                const u32 numInRadius = bvh.FindInRadius(point, 40.0f, indices, std::size(indices));
+                assert(numInRadius == bruteInRadius && "Test Case 2 Failed: Radius query differs from brute force.");
+                for (u32 i = 0; i < std::min<u32>(numInRadius, std::size(indices)); i++)
+                {
+                    assert(CCurveBVH::DistToCurve(bvh.GetCurve(indices[i]), point) <= 40.0f &&
+                           "Test Case 2 Failed: Radius query returned a curve outside the radius.");
+                }
+            }
+        };
+
+        // Test Case 1: CCurveBVH - Bounds contain every point CalcCurvePoint returns
+        for (const CCurveSegment& segment : segments)
+        {
+            const CCurveBounds bounds = CCurveBVH::CalcBounds(segment);
+            for (u32 i = 0; i <= 256; i++)
+            {
+                CVector resultCoor, resultSpeed;
+                CalcCurvePoint(segment, static_cast<f32>(i) / 256.0f, 1000, resultCoor, resultSpeed);
+                assert(resultCoor.x >= bounds.Min.x && resultCoor.y >= bounds.Min.y && resultCoor.z >= bounds.Min.z &&
+                       resultCoor.x <= bounds.Max.x && resultCoor.y <= bounds.Max.y && resultCoor.z <= bounds.Max.z &&
+                       "Test Case 1 Failed: Curve point outside its bounds.");
+            }
+        }
+
+        // Test Case 2: CCurveBVH - Queries match brute force
+        CCurveBVH bvh(segments.data(), static_cast<u32>(segments.size()));
+        CheckQueries(bvh);
+
+        // Test Case 3: CCurveBVH - Queries still match brute force after moving curves and refitting
+        for (u32 i = 0; i < segments.size(); i += 3)
+        {
+            const CCurveSegment& curve = segments[i];
+            const CVector offset(25.0f, -40.0f, 1.0f);
+            bvh.SetCurve(i, CCurveSegment(curve.StartCoors + offset, curve.EndCoors + offset, curve.StartDir, curve.EndDir));
+        }
+        bvh.Refit();
+        CheckQueries(bvh);
+
+        // Test Case 4: CCurveBVH - Nothing within MaxDist
+        assert(bvh.FindNearest(CVector(5000.0f, 5000.0f, 0.0f), 100.0f) == -1 &&
+               "Test Case 4 Failed: Found a curve further than MaxDist.");
+    };
+
+    auto CCurveConflicts_test = [&]
+    {
+        // Test Case 1: CCurveConflicts - Two agents crossing a junction at the same time
+        {
+            const CCurveSegment east(CVector(-50.0f, 0.0f, 0.0f), CVector(50.0f, 0.0f, 0.0f), CVector(1.0f, 0.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f));
+            const CCurveSegment north(CVector(0.0f, -50.0f, 0.0f), CVector(0.0f, 50.0f, 0.0f),
+                CVector(0.0f, 1.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+            const CCurveAgent agents[3] = {
+                {&east, 0.0f, 10000, 2.0f},
+                {&north, 0.0f, 10000, 2.0f},
+                {&north, 0.9f, 10000, 2.0f},  // already through the junction
+            };
+
+            CCurveConflicts conflicts;
+            conflicts.Update(agents, 3, 8000.0f);
+            assert(conflicts.GetNumConflicts() == 1 && "Test Case 1 Failed: Expected one conflict.");
+
+            // closest at the junction after 5 s, contact 4 / sqrt(2) units before the junction, where the 4-unit
+            // combined radius is reached
+            const CCurveConflict& conflict = conflicts.GetConflict(0);
+            assert(conflict.AgentA == 0 && conflict.AgentB == 1 && "Test Case 1 Failed: Incorrect agents.");
+            assert(std::fabs(conflict.ClosestTime - 5000.0f) < 1.0f && conflict.ClosestDist < 0.01f &&
+                   std::fabs(conflict.ContactTime - (5000.0f - 100.0f * 4.0f / std::sqrt(2.0f))) < 1.0f &&
+                   "Test Case 1 Failed: Incorrect closest approach.");
+        }
+
+        // Test Case 2: CCurveConflicts - Same conflicts as checking every pair
+        {
+            const std::vector<CCurveSegment> segments =
+                ScatteredSegments(300, CVector(0.0f, 0.0f, 0.0f), 200, 10.0f, 10.0f, 0.0f);
+
+            std::vector<CCurveAgent> agents;
+            for (u32 i = 0; i < 300; i++)
+            {
+                agents.push_back({&segments[i], static_cast<f32>(i % 10) * 0.1f, 2000 + static_cast<i32>(i % 5) * 1000,
+                    1.0f + static_cast<f32>(i % 3) * 0.5f});
+            }
+
+            CCurveConflicts conflicts;
+            conflicts.Update(agents.data(), 300, 1500.0f);
+
+            u32 numExpected = 0;
+            for (u32 a = 0; a < 300; a++)
+            {
+                for (u32 b = a + 1; b < 300; b++)
+                {
+                    CCurveConflict expected;
+                    if (!CCurveConflicts::CalcClosestApproach(agents[a], agents[b], 1500.0f, expected))
+                    {
+                        continue;
+                    }
+                    numExpected++;
+
+                    bool bFound = false;
+                    for (u32 i = 0; i < conflicts.GetNumConflicts() && !bFound; i++)
+                    {
+                        const CCurveConflict& conflict = conflicts.GetConflict(i);
+                        bFound = conflict.AgentA == a && conflict.AgentB == b &&
+                                 conflict.ContactTime == expected.ContactTime &&
+                                 conflict.ClosestTime == expected.ClosestTime &&
+                                 conflict.ClosestDist == expected.ClosestDist;
+                    }
+                    assert(bFound && "Test Case 2 Failed: Missed a conflict.");
+                }
+            }
+            assert(numExpected > 0 && conflicts.GetNumConflicts() == numExpected &&
+                   conflicts.GetNumCandidates() < 300 * 299 / 8 && "Test Case 2 Failed: Incorrect conflicts.");
+        }
+    };
+
+    // Same cases as the runtime tests above, evaluated by the compiler
+    auto CCurveMath_test = []
+    {
+        constexpr auto CurvePoint = [](const CVector& startCoors, const CVector& endCoors, const CVector& startDir,
+                                        const CVector& endDir, f32 Time)
+        {
+            CVector resultCoor, resultSpeed;
+            CCurveMath::CalcCurvePoint(startCoors, endCoors, startDir, endDir, Time, 1000, resultCoor, resultSpeed);
+            return resultCoor;
+        };
+
+        // Test Case 1: CCurveMath - DistForLineToCrossOtherLine
+        static_assert(FLOAT_EQUAL(CCurveMath::DistForLineToCrossOtherLine(0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, -1.0f, 1.0f),
+                          0.5f) &&
+                      "Test Case 1 Failed: Expected distance to crossing.");
+        static_assert(FLOAT_EQUAL(CCurveMath::DistForLineToCrossOtherLine(0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f),
+                          -1.0f) &&
+                      "Test Case 1 Failed: Expected -1 for parallel lines.");
+        static_assert(FLOAT_EQUAL(CCurveMath::DistForLineToCrossOtherLine(
+                                      2500.5f, 1500.0f, 3.5f, 2.5f, 3000.0f, 2000.0f, -4.0f, 3.0f),
+                          170.658539f) &&
+                      "Test Case 1 Failed: Expected distance to crossing.");
+
+        // Test Case 2: CCurveMath - CalcSpeedVariationInBend
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedVariationInBend(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f, 0.0f, -1.0f, 0.0f),
+                          1.0f / 3.0f) &&
+                      "Test Case 2 Failed: Expected 0.33333.");
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedVariationInBend(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f, 0.0f, 0.9f, 0.1f),
+                          0.145296633f) &&
+                      "Test Case 2 Failed: Incorrect speed variation.");
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedVariationInBend(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, 1.0f, 0.0f, 0.8f, 0.2f),
+                          0.235702246f) &&
+                      "Test Case 2 Failed: Incorrect speed variation.");
+
+        // Test Case 3: CCurveMath - CalcSpeedScaleFactor
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedScaleFactor(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, 1.0f, 0.0f, 0.0f, 1.0f),
+                          2.0f) &&
+                      "Test Case 3 Failed: Incorrect speed scale factor.");
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedScaleFactor(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f, 0.0f, 0.0f, 1.0f),
+                          1.5f) &&
+                      "Test Case 3 Failed: Incorrect speed scale factor.");
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedScaleFactor(
+                                      {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, 1.0f, 1.0f, 1.0f, 1.0f),
+                          1.4142135f) &&
+                      "Test Case 3 Failed: Incorrect speed scale factor.");
+        static_assert(FLOAT_EQUAL(CCurveMath::CalcSpeedScaleFactor(
+                                      {2500.0f, 1500.0f, 0.0f}, {3500.0f, 2000.0f, 0.0f}, 2.0f, 1.0f, 3.0f, 2.0f),
+                          1118.03394f) &&
+                      "Test Case 3 Failed: Incorrect speed scale factor.");
+
+        // Test Case 4: CCurveMath - CalcCorrectedDist
+        static_assert(
+            []
+            {
+                f32 interpol = 0.0f;
+                const f32 correctedDist = CCurveMath::CalcCorrectedDist(500.0f, 1000.0f, 0.5f, &interpol);
+                return FLOAT_EQUAL(correctedDist, 250.0f) && FLOAT_EQUAL(interpol, 0.5f);
+            }() &&
+            "Test Case 4 Failed: Incorrect corrected distance.");
+
+        // Test Case 5: CCurveMath - CalcCurvePoint, crossing and fallback curves
+        static_assert(FLOAT_EQUAL(CurvePoint({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                                      {1.0f, 0.0f, 0.0f}, 0.5f).x,
+                          0.5f) &&
+                      "Test Case 5 Failed: Incorrect curve point.");
+        static_assert(FLOAT_EQUAL(CurvePoint({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                                      {-1.0f, 0.0f, 0.0f}, 0.5f).x,
+                          1.0f) &&
+                      "Test Case 5 Failed: Incorrect curve point.");
+
+        // Test Case 6: CCurveMath - A table of curve points built at compile time
+        {
+            constexpr auto table = [&]
+            {
+                std::array<CVector, 9> points;
+                for (u32 i = 0; i < points.size(); i++)
+                {
+                    points[i] = CurvePoint({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                        {0.0f, 1.0f, 0.0f}, static_cast<f32>(i) / (points.size() - 1));
+                }
+                return points;
+            }();
+
+            static_assert(FLOAT_EQUAL(table.front().x, 0.0f) && FLOAT_EQUAL(table.front().y, 0.0f) &&
+                          FLOAT_EQUAL(table.back().x, 1.0f) && FLOAT_EQUAL(table.back().y, 1.0f) &&
+                          "Test Case 6 Failed: Table should run from the start to the end point.");
+
+            for (u32 i = 0; i < table.size(); i++)
+            {
+                CVector resultCoor, resultSpeed;
+                CalcCurvePoint({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+                    static_cast<f32>(i) / (table.size() - 1), 1000, resultCoor, resultSpeed);
+                assert(FLOAT_EQUAL(table[i].x, resultCoor.x) && FLOAT_EQUAL(table[i].y, resultCoor.y) &&
+                       "Test Case 6 Failed: Compile-time point differs from the runtime one.");
+            }
+        }
+
+        // Test Case 7: CCurveMathT - The Fast precision policy stays within Approx of the Exact one
+        {
+            const CVector curves[][4] = {
+                {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                {{0.0f, 0.0f, 0.0f}, {20.0f, 20.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}},
+                {{0.0f, 0.0f, 0.0f}, {10.0f, 3.0f, 2.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                {{2500.0f, 1500.0f, 10.0f}, {2520.0f, 1512.0f, 12.0f}, {0.8f, 0.6f, 0.0f}, {0.6f, 0.8f, 0.0f}},
+            };
+
+            for (const auto& [startCoors, endCoors, startDir, endDir] : curves)
+            {
+                const f32 exactScale = CCurveMathT<CCurveExact>::CalcSpeedScaleFactor(
+                    startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+                const f32 fastScale = CCurveMathT<CCurveFast>::CalcSpeedScaleFactor(
+                    startCoors, endCoors, startDir.x, startDir.y, endDir.x, endDir.y);
+                assert(FLOAT_EQUAL(fastScale, exactScale) && "Test Case 7 Failed: Incorrect speed scale factor.");
+
+                for (f32 time : {0.0f, 0.2f, 0.5f, 0.8f, 1.0f})
+                {
+                    CVector exactCoor, exactSpeed, fastCoor, fastSpeed;
+                    CCurveMathT<CCurveExact>::CalcCurvePoint(
+                        startCoors, endCoors, startDir, endDir, time, 1000, exactCoor, exactSpeed);
+                    CCurveMathT<CCurveFast>::CalcCurvePoint(
+                        startCoors, endCoors, startDir, endDir, time, 1000, fastCoor, fastSpeed);
+
+                    assert(FLOAT_EQUAL(fastCoor.x, exactCoor.x) && FLOAT_EQUAL(fastCoor.y, exactCoor.y) &&
+                           FLOAT_EQUAL(fastCoor.z, exactCoor.z) && "Test Case 7 Failed: Incorrect curve point.");
+                    assert(FLOAT_EQUAL(fastSpeed.x, exactSpeed.x) && FLOAT_EQUAL(fastSpeed.y, exactSpeed.y) &&
+                           "Test Case 7 Failed: Incorrect curve speed.");
+                }
+            }
+        }
+
+        // Test Case 8: CCurveFast - Dividing by zero or a denormal gives a signed infinity like the plain divide
+        {
+            assert(CCurveFast::Div(3.0f, 4.0f) == Approx(0.75f) && "Test Case 8 Failed: Incorrect quotient.");
+            assert(CCurveFast::Div(1.0f, 0.0f) == std::numeric_limits<f32>::infinity() &&
+                   CCurveFast::Div(1.0f, -0.0f) == -std::numeric_limits<f32>::infinity() &&
+                   "Test Case 8 Failed: Division by zero should give infinity.");
+            assert(CCurveFast::Div(-1.0f, 1e-40f) == -std::numeric_limits<f32>::infinity() &&
+                   "Test Case 8 Failed: Division by a denormal should overflow to infinity.");
+        }
+    };
+
+#ifdef CURVES_STATS
+    auto CCurveStats_test = []
+    {
+        // Test Case 1: CCurveStats - Every branch of CalcCurvePoint counted once
+        {
+            CCurveStats::Reset();
+
+            // 90 degree turn with 10 units of straight on both sides of the bend
+            const CVector startCoors(0.0f, 0.0f, 0.0f);
+            const CVector endCoors(15.0f, 15.0f, 0.0f);
+            const CVector startDir(1.0f, 0.0f, 0.0f);
+            const CVector endDir(0.0f, 1.0f, 0.0f);
+
+            CVector resultCoor, resultSpeed;
+            CCurveMath::CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.1f, 1000, resultCoor, resultSpeed);
+            CCurveMath::CalcCurvePoint(startCoors, endCoors, startDir, endDir, 0.5f, 1000, resultCoor, resultSpeed);
+            CCurveMath::CalcCurvePoint(startCoors, endCoors, startDir, endDir, 1.5f, 1000, resultCoor, resultSpeed);
+            CCurveMath::CalcCurvePoint(startCoors, endCoors, startDir * -1.0f, endDir, 0.5f, 1000, resultCoor,
+                resultSpeed);
+
+            const CCurveStats::CSnapshot snapshot = CCurveStats::GetSnapshot();
+            assert(snapshot.Counters[CCurveStats::CURVE_POINT_FIRST_STRAIGHT] == 1 &&
+                   snapshot.Counters[CCurveStats::CURVE_POINT_BEND] == 1 &&
+                   snapshot.Counters[CCurveStats::CURVE_POINT_SECOND_STRAIGHT] == 1 &&
+                   snapshot.Counters[CCurveStats::CURVE_POINT_FALLBACK] == 1 &&
+                   snapshot.Counters[CCurveStats::CURVE_POINT_TIME_CLAMPED] == 1 &&
+                   "Test Case 1 Failed: Incorrect branch counts.");
+            assert(snapshot.Counters[CCurveStats::DIST_FOR_LINE_CALLS] == 8 &&
+                   snapshot.Counters[CCurveStats::SPEED_VARIATION_DOT_BELOW_ZERO] == 4 &&
+                   snapshot.Counters[CCurveStats::CORRECTED_DIST_CALLS] == 1 &&
+                   "Test Case 1 Failed: Incorrect counts of the nested calls.");
+
+            // 1.5 lands above the Time range, 0.1 and 0.5 in their buckets
+            const u64* pTimes = snapshot.Histograms[CCurveStats::HISTOGRAM_CURVE_POINT_TIME];
+            assert(pTimes[CCurveStats::NUM_BUCKETS + 1] == 1 && pTimes[1 + 1] == 1 &&
+                   pTimes[1 + CCurveStats::NUM_BUCKETS / 2] == 2 && "Test Case 1 Failed: Incorrect histogram.");
+        }
+
+        // Test Case 2: CCurveStats - Counts of exited threads are kept, Reset drops them
+        {
+            CCurveStats::Reset();
+
+            const CCurveSegment segment(CVector(0.0f, 0.0f, 0.0f), CVector(15.0f, 15.0f, 0.0f),
+                CVector(1.0f, 0.0f, 0.0f), CVector(0.0f, 1.0f, 0.0f));
+
+            std::vector<std::thread> threads;
+            for (u32 t = 0; t < 4; t++)
+            {
+                threads.emplace_back(
+                    [&segment]
+                    {
+                        CVector resultCoor, resultSpeed;
+                        for (u32 i = 0; i < 1000; i++)
+                        {
+                            CalcCurvePoint(segment, 0.5f, 1000, resultCoor, resultSpeed);
+                        }
+                    });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            assert(CCurveStats::GetSnapshot().Counters[CCurveStats::CURVE_POINT_BEND] == 4000 &&
+                   "Test Case 2 Failed: Counts of exited threads lost.");
+
+            CCurveStats::Reset();
+            assert(CCurveStats::GetSnapshot().Counters[CCurveStats::CURVE_POINT_BEND] == 0 &&
+                   "Test Case 2 Failed: Counts survived Reset.");
+        }
+    };
+#endif
+
+    DistForLineToCrossOtherLine_test();
+    CalcSpeedVariationInBend_test();
+    CalcSpeedScaleFactor_test();
+    CalcCurvePoint_test();
+    CalcCorrectedDist_test();
+    CalcCurvePoints_test();
+    CCurveSegment_test();
+    CalcCurveState_test();
+    CalcCorrectedDistFast_test();
+    CCurveArcLength_test();
+    CCurveCursor_test();
+    CVectorSimd_test();
+    FindClosestTime_test();
+    CCurveRoute_test();
+    CalcCurveLength_test();
+    CalcCurvePointBranchless_test();
+    CalcCurvePolyline_test();
+    CCompactCurve_test();
+    CCurveCorpus_test();
+    CCurveNetwork_test();
+    CCurveBVH_test();
+    CCurveConflicts_test();
+    CCurveMath_test();
+    CCurveThreadPool_test();
+#ifdef CURVES_STATS
+    CCurveStats_test();
+#endif
+}
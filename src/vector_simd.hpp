@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VECTOR_SIMD_SSE 1
+#endif
+
+#include "curves.hpp"
+#include "maths.hpp"
+
+/// `CVector` padded to 16 bytes and 16-byte aligned, so that it lives in one SSE register.
+///
+/// x, y and z sit at the same offsets as in `CVector`, callers convert implicitly in both directions and keep passing
+/// `CVector` around; the conversion is a load/store of the first 12 bytes. w is padding, kept at 0 by everything
+/// built from a `CVector` or three components so it never leaks into `Dot` / `Magnitude`. All arithmetic is packed
+/// at runtime and plain scalar code during constant evaluation.
+struct alignas(16) CVectorSimd
+{
+    f32 x, y, z, w;
+
+    constexpr CVectorSimd() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+    constexpr CVectorSimd(f32 _x, f32 _y, f32 _z, f32 _w = 0.0f) : x(_x), y(_y), z(_z), w(_w) {}
+
+#ifdef VECTOR_SIMD_SSE
+    explicit CVectorSimd(__m128 v) { _mm_store_ps(&x, v); }
+    __m128 Get() const { return _mm_load_ps(&x); }
+#endif
+
+    constexpr CVectorSimd(const CVector& v) : x(v.x), y(v.y), z(v.z), w(0.0f)
+    {
+#ifdef VECTOR_SIMD_SSE
+        // one 8-byte and one 4-byte load straight into the register, instead of bouncing the scalars off the stack
+        if !consteval
+        {
+            const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&v.x));
+            _mm_store_ps(&x, _mm_movelh_ps(xy, _mm_load_ss(&v.z)));
+        }
+#endif
+    }
+
+    constexpr operator CVector() const { return CVector(x, y, z); }
+
+    constexpr CVectorSimd operator+(const CVectorSimd& o) const
+    {
+#ifdef VECTOR_SIMD_SSE
+        if !consteval
+        {
+            return CVectorSimd(_mm_add_ps(Get(), o.Get()));
+        }
+#endif
+        return CVectorSimd(x + o.x, y + o.y, z + o.z, w + o.w);
+    }
+
+    constexpr CVectorSimd operator-(const CVectorSimd& o) const
+    {
+#ifdef VECTOR_SIMD_SSE
+        if !consteval
+        {
+            return CVectorSimd(_mm_sub_ps(Get(), o.Get()));
+        }
+#endif
+        return CVectorSimd(x - o.x, y - o.y, z - o.z, w - o.w);
+    }
+
+    constexpr CVectorSimd operator*(const CVectorSimd& o) const
+    {
+#ifdef VECTOR_SIMD_SSE
+        if !consteval
+        {
+            return CVectorSimd(_mm_mul_ps(Get(), o.Get()));
+        }
+#endif
+        return CVectorSimd(x * o.x, y * o.y, z * o.z, w * o.w);
+    }
+
+    constexpr CVectorSimd operator*(f32 s) const
+    {
+#ifdef VECTOR_SIMD_SSE
+        if !consteval
+        {
+            return CVectorSimd(_mm_mul_ps(Get(), _mm_set1_ps(s)));
+        }
+#endif
+        return CVectorSimd(x * s, y * s, z * s, w * s);
+    }
+
+    constexpr CVectorSimd operator/(f32 s) const { return *this * (1.0f / s); }
+    constexpr CVectorSimd operator-() const { return CVectorSimd(-x, -y, -z, -w); }
+
+    constexpr CVectorSimd& operator+=(const CVectorSimd& o) { return *this = *this + o; }
+    constexpr CVectorSimd& operator-=(const CVectorSimd& o) { return *this = *this - o; }
+    constexpr CVectorSimd& operator*=(f32 s) { return *this = *this * s; }
+
+    constexpr f32 Dot(const CVectorSimd& o) const { return x * o.x + y * o.y + z * o.z; }
+    constexpr f32 Dot2D(const CVectorSimd& o) const { return x * o.x + y * o.y; }
+
+    constexpr f32 MagnitudeSqr() const { return Dot(*this); }
+    constexpr f32 MagnitudeSqr2D() const { return Dot2D(*this); }
+    constexpr f32 Magnitude() const { return CMaths::Sqrt(MagnitudeSqr()); }
+    constexpr f32 Magnitude2D() const { return CMaths::Sqrt(MagnitudeSqr2D()); }
+};
+
+static_assert(sizeof(CVectorSimd) == 16 && alignof(CVectorSimd) == 16);
+static_assert(offsetof(CVectorSimd, x) == offsetof(CVector, x) && offsetof(CVectorSimd, y) == offsetof(CVector, y) &&
+              offsetof(CVectorSimd, z) == offsetof(CVector, z));
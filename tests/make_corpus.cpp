@@ -0,0 +1,63 @@
+// Writes a CCurveCorpus with the outputs of the CCurves this is linked against, for curves-tests --corpus
+//
+//   curves-corpus <file> [--count N] [--seed S] [--threads T]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "curve_corpus.hpp"
+#include "curve_thread_pool.hpp"
+
+int main(int argc, char** argv)
+{
+    const char* pPath = nullptr;
+    u64 count = 1u << 20;
+    u64 seed = 1337;
+    u32 numThreads = 0;
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--count") && i + 1 < argc)
+        {
+            count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+        {
+            numThreads = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!pPath && argv[i][0] != '-')
+        {
+            pPath = argv[i];
+        }
+        else
+        {
+            pPath = nullptr;
+            break;
+        }
+    }
+
+    if (!pPath)
+    {
+        std::fprintf(stderr, "usage: %s <file> [--count N] [--seed S] [--threads T]\n", argv[0]);
+        return 2;
+    }
+
+    CCurveThreadPool pool(numThreads);
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!CCurveCorpus::Write(pPath, count, seed, &pool))
+    {
+        std::fprintf(stderr, "can't write %s\n", pPath);
+        return 1;
+    }
+
+    std::printf("%llu records per function written to %s in %.1f s\n", static_cast<unsigned long long>(count), pPath,
+        std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count());
+    return 0;
+}
@@ -0,0 +1,383 @@
+// Native test runner, no game needed: the TestCurves cases, then randomized property tests over millions of curves
+// spread across a CCurveThreadPool, and a CCurveCorpus when given one (curves-corpus writes them). Exits with 1 when
+// a property or corpus record fails, the asserts of TestCurves abort.
+//
+//   curves-tests [--count N] [--seed S] [--threads T] [--no-unit] [--corpus file]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "curve_corpus.hpp"
+#include "curve_inputs.hpp"
+#include "curve_thread_pool.hpp"
+#include "curves.hpp"
+#include "maths.hpp"
+
+namespace
+{
+// Bound for rounding in results built from MakeCurveInput curves, scaled by the largest magnitude involved
+f32 Tolerance(const CCurveInput& in, f32 Length)
+{
+    const f32 coords = std::max({std::fabs(in.startCoors.x), std::fabs(in.startCoors.y), std::fabs(in.startCoors.z),
+        std::fabs(in.endCoors.x), std::fabs(in.endCoors.y), std::fabs(in.endCoors.z)});
+    return 1e-5f + 32.0f * FLT_EPSILON * (coords + Length);
+}
+
+f32 Distance(const CVector& a, const CVector& b)
+{
+    return (a - b).Magnitude();
+}
+
+bool BitEqual(const CVector& a, const CVector& b)
+{
+    return std::memcmp(&a, &b, sizeof(CVector)) == 0;
+}
+
+CVector CalcPoint(const CCurveInput& in, f32 Time)
+{
+    CVector resultCoor, resultSpeed;
+    CCurves::CalcCurvePoint(in.startCoors, in.endCoors, in.startDir, in.endDir, Time, 1000, resultCoor, resultSpeed);
+    return resultCoor;
+}
+
+// Time outside [0, 1] gives exactly the point and speed at the nearest end, for both overloads
+bool TimeClamping(const CCurveInput& in)
+{
+    const f32 Time = in.Time < 0.5f ? std::min(in.Time, 0.0f) - 0.5f : std::max(in.Time, 1.0f) + 0.5f;
+    const f32 clamped = Time < 0.0f ? 0.0f : 1.0f;
+
+    CVector coor, speed, clampedCoor, clampedSpeed;
+    CCurves::CalcCurvePoint(in.startCoors, in.endCoors, in.startDir, in.endDir, Time, 1000, coor, speed);
+    CCurves::CalcCurvePoint(
+        in.startCoors, in.endCoors, in.startDir, in.endDir, clamped, 1000, clampedCoor, clampedSpeed);
+    if (!BitEqual(coor, clampedCoor) || !BitEqual(speed, clampedSpeed))
+    {
+        return false;
+    }
+
+    const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    CCurves::CalcCurvePoint(segment, Time, 1000, coor, speed);
+    CCurves::CalcCurvePoint(segment, clamped, 1000, clampedCoor, clampedSpeed);
+    return BitEqual(coor, clampedCoor) && BitEqual(speed, clampedSpeed);
+}
+
+// Curves start on startCoors and end on endCoors, but for crossing curves with a second straight, which starts on
+// endCoors and ends its length past it. Not for fallback curves whose ends share x and y, CalcCorrectedDist parks
+// those at the midpoint.
+bool Endpoints(const CCurveInput& in)
+{
+    const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    if (!segment.bCrossing && segment.BendDist < 0.00001f)
+    {
+        return true;
+    }
+
+    const f32 tolerance = Tolerance(in, CCurves::CalcSpeedScaleFactor(segment));
+    const CVector end = segment.bCrossing ? in.endCoors + in.endDir * segment.StraightDist2 : in.endCoors;
+    return Distance(CalcPoint(in, 0.0f), in.startCoors) <= tolerance && Distance(CalcPoint(in, 1.0f), end) <= tolerance;
+}
+
+// No jump where a crossing curve switches from the first straight to the bend, and the second straight starts on
+// endCoors. Only in x and y, the straights take their height from their own end and direction, which with a slope
+// don't meet at the crossing.
+bool BendJoins(const CCurveInput& in)
+{
+    const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    if (!segment.bCrossing || segment.TotalDist_Time <= 0.0f)
+    {
+        return true;
+    }
+
+    const f32 tolerance = Tolerance(in, segment.TotalDist_Time);
+    const f32 Time = segment.StraightDist1 / segment.TotalDist_Time;
+    const f32 before = std::nextafter(Time, 0.0f);
+    const f32 after = std::nextafter(Time, 1.0f);
+    const f32 secondStraightTime = segment.GetSecondStraightTime();
+
+    // the curve moves at most about twice the total distance per unit of Time in the bend. Far away crossings can
+    // have a bend shorter than a Time step, the step after the first straight lands on the second one then.
+    const f32 step = 2.0f * segment.TotalDist_Time * in.startDir.Magnitude() * (after - before);
+    const CVector jump = CalcPoint(in, after) - CalcPoint(in, before);
+    if (after < secondStraightTime && jump.Magnitude2D() > step + tolerance)
+    {
+        return false;
+    }
+
+    return secondStraightTime >= 1.0f ||
+           (CalcPoint(in, secondStraightTime) - in.endCoors).Magnitude2D() <= step + tolerance;
+}
+
+// Running a crossing curve backwards (ends and directions swapped) swaps its crossing distances, the reversed curve
+// traces the same bend and both rays meet in the same point
+bool CrossingSymmetry(const CCurveInput& in)
+{
+    const f32 DistToPoint1 = CCurves::DistForLineToCrossOtherLine(in.startCoors.x, in.startCoors.y, in.startDir.x,
+        in.startDir.y, in.endCoors.x, in.endCoors.y, in.endDir.x, in.endDir.y);
+    const f32 DistToPoint2 = -CCurves::DistForLineToCrossOtherLine(in.endCoors.x, in.endCoors.y, in.endDir.x,
+        in.endDir.y, in.startCoors.x, in.startCoors.y, in.startDir.x, in.startDir.y);
+
+    const CCurveInput reversed = {in.endCoors, in.startCoors, in.endDir * -1.0f, in.startDir * -1.0f, 1.0f - in.Time};
+    const f32 reversedDistToPoint1 = CCurves::DistForLineToCrossOtherLine(reversed.startCoors.x, reversed.startCoors.y,
+        reversed.startDir.x, reversed.startDir.y, reversed.endCoors.x, reversed.endCoors.y, reversed.endDir.x,
+        reversed.endDir.y);
+    const f32 reversedDistToPoint2 = -CCurves::DistForLineToCrossOtherLine(reversed.endCoors.x, reversed.endCoors.y,
+        reversed.endDir.x, reversed.endDir.y, reversed.startCoors.x, reversed.startCoors.y, reversed.startDir.x,
+        reversed.startDir.y);
+
+    // parallel rays return -1 both ways, which the negation of DistToPoint2 doesn't keep symmetric
+    const f32 cross = in.startDir.x * in.endDir.y - in.startDir.y * in.endDir.x;
+    if (cross == 0.0f)
+    {
+        return true;
+    }
+
+    // negating both directions flips the sign of every product exactly
+    if (reversedDistToPoint1 != DistToPoint2 || reversedDistToPoint2 != DistToPoint1)
+    {
+        return false;
+    }
+
+    const CCurveSegment segment(in.startCoors, in.endCoors, in.startDir, in.endDir);
+    if (!segment.bCrossing)
+    {
+        return true;
+    }
+
+    // in x and y, the bend blends between two heights that don't meet (see BendJoins) and magnifies the rounding.
+    // Only inside the bend, the second straights start on the other end and 1 - Time rounds across the joins.
+    const f32 Time = std::clamp(in.Time, 0.0f, 1.0f);
+    const f32 tolerance = Tolerance(in, DistToPoint1 + DistToPoint2);
+    const f32 distanceAtTime = segment.TotalDist_Time * Time;
+    const f32 margin = 1e-4f * segment.TotalDist_Time;
+    if (distanceAtTime > segment.StraightDist1 + margin &&
+        distanceAtTime < segment.StraightDist1 + segment.BendDist - margin &&
+        (CalcPoint(in, Time) - CalcPoint(reversed, 1.0f - Time)).Magnitude2D() > tolerance)
+    {
+        return false;
+    }
+
+    // nearly parallel rays cancel the cross product down to its rounding, their crossing is only as exact as that
+    if (std::fabs(cross) < 0.01f)
+    {
+        return true;
+    }
+
+    const CVector crossing1 = in.startCoors + in.startDir * DistToPoint1;
+    const CVector crossing2 = in.endCoors - in.endDir * DistToPoint2;
+    return std::hypot(crossing1.x - crossing2.x, crossing1.y - crossing2.y) <= tolerance;
+}
+
+// CalcCurvePointBranchless gives exactly what CalcCurvePoint does, the native build always has the custom one
+bool Branchless(const CCurveInput& in)
+{
+    CVector coor, speed, branchlessCoor, branchlessSpeed;
+    CCurves::CalcCurvePoint(in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, coor, speed);
+    CCurves::CalcCurvePointBranchless(
+        in.startCoors, in.endCoors, in.startDir, in.endDir, in.Time, 1000, branchlessCoor, branchlessSpeed);
+    return BitEqual(coor, branchlessCoor) && BitEqual(speed, branchlessSpeed);
+}
+
+struct CProperty
+{
+    const char* Name;
+    bool (*pfnCheck)(const CCurveInput& in);
+};
+
+constexpr CProperty PROPERTIES[] = {
+    {"Time clamping", TimeClamping},
+    {"endpoints", Endpoints},
+    {"bend joins", BendJoins},
+    {"crossing symmetry", CrossingSymmetry},
+    {"branchless", Branchless},
+};
+
+constexpr u32 INPUTS_PER_CHUNK = 16384;
+
+struct CPropertyRun
+{
+    const CProperty* pProperty;
+    u64 Seed;
+    u64 Count;
+    std::atomic<u64> NumFailures;
+    std::atomic<u64> FirstFailure;  // smallest failing index, Count if none
+};
+
+void CheckChunk(void* pContext, u32 Chunk)
+{
+    CPropertyRun& run = *static_cast<CPropertyRun*>(pContext);
+
+    const u64 begin = static_cast<u64>(Chunk) * INPUTS_PER_CHUNK;
+    const u64 end = std::min(begin + INPUTS_PER_CHUNK, run.Count);
+
+    u64 numFailures = 0;
+    for (u64 i = begin; i < end; i++)
+    {
+        if (run.pProperty->pfnCheck(MakeCurveInput(run.Seed, i)))
+        {
+            continue;
+        }
+
+        if (numFailures++ == 0)
+        {
+            u64 first = run.FirstFailure.load(std::memory_order_relaxed);
+            while (i < first && !run.FirstFailure.compare_exchange_weak(first, i, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+    run.NumFailures.fetch_add(numFailures, std::memory_order_relaxed);
+}
+
+constexpr u64 RECORDS_PER_CHUNK = 65536;
+
+struct CCorpusRun
+{
+    const CCurveCorpus* pCorpus;
+    CCurveCorpus::eFunction Function;
+    std::atomic<u64> NumMismatches;
+    std::atomic<u64> FirstMismatch;
+};
+
+void VerifyChunk(void* pContext, u32 Chunk)
+{
+    CCorpusRun& run = *static_cast<CCorpusRun*>(pContext);
+
+    const u64 begin = static_cast<u64>(Chunk) * RECORDS_PER_CHUNK;
+    const u64 end = std::min(begin + RECORDS_PER_CHUNK, run.pCorpus->GetNumRecords(run.Function));
+    const CCurveCorpus::CVerifyResult result = run.pCorpus->Verify(run.Function, begin, end);
+    if (!result.NumMismatches)
+    {
+        return;
+    }
+
+    run.NumMismatches.fetch_add(result.NumMismatches, std::memory_order_relaxed);
+    u64 first = run.FirstMismatch.load(std::memory_order_relaxed);
+    while (result.FirstMismatch < first &&
+           !run.FirstMismatch.compare_exchange_weak(first, result.FirstMismatch, std::memory_order_relaxed))
+    {
+    }
+}
+
+void PrintInput(const CCurveInput& in)
+{
+    std::printf("    startCoors (%.9g, %.9g, %.9g) endCoors (%.9g, %.9g, %.9g)\n", in.startCoors.x, in.startCoors.y,
+        in.startCoors.z, in.endCoors.x, in.endCoors.y, in.endCoors.z);
+    std::printf("    startDir (%.9g, %.9g, %.9g) endDir (%.9g, %.9g, %.9g) Time %.9g\n", in.startDir.x, in.startDir.y,
+        in.startDir.z, in.endDir.x, in.endDir.y, in.endDir.z, in.Time);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    u64 count = 1u << 21;
+    u64 seed = 1337;
+    u32 numThreads = 0;
+    bool bUnitTests = true;
+    const char* pCorpusPath = nullptr;
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--count") && i + 1 < argc)
+        {
+            count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+        {
+            numThreads = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!std::strcmp(argv[i], "--no-unit"))
+        {
+            bUnitTests = false;
+        }
+        else if (!std::strcmp(argv[i], "--corpus") && i + 1 < argc)
+        {
+            pCorpusPath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(
+                stderr, "usage: %s [--count N] [--seed S] [--threads T] [--no-unit] [--corpus file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    if (bUnitTests)
+    {
+        const auto start = Clock::now();
+        CCurves::TestCurves();
+        std::printf("TestCurves passed in %.1f ms\n",
+            std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+    }
+
+    CCurveThreadPool pool(numThreads);
+    std::printf("property tests over %llu curves, seed %llu, %u threads\n", static_cast<unsigned long long>(count),
+        static_cast<unsigned long long>(seed), pool.GetNumThreads());
+
+    bool bPassed = true;
+    for (const CProperty& property : PROPERTIES)
+    {
+        CPropertyRun run = {&property, seed, count, {0}, {count}};
+
+        const auto start = Clock::now();
+        pool.Run(static_cast<u32>((count + INPUTS_PER_CHUNK - 1) / INPUTS_PER_CHUNK), CheckChunk, &run);
+        const f64 millis = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+
+        const u64 numFailures = run.NumFailures.load();
+        std::printf("  %-20s %s in %.1f ms\n", property.Name, numFailures ? "FAILED" : "passed", millis);
+        if (numFailures)
+        {
+            const u64 first = run.FirstFailure.load();
+            std::printf("    %llu failures, first at index %llu:\n", static_cast<unsigned long long>(numFailures),
+                static_cast<unsigned long long>(first));
+            PrintInput(MakeCurveInput(seed, first));
+            bPassed = false;
+        }
+    }
+
+    if (pCorpusPath)
+    {
+        CCurveCorpus corpus;
+        if (!corpus.Open(pCorpusPath))
+        {
+            std::printf("can't open the corpus %s\n", pCorpusPath);
+            return 1;
+        }
+
+        std::printf("corpus %s, seed %llu\n", pCorpusPath, static_cast<unsigned long long>(corpus.GetHeader().Seed));
+        for (u32 f = 0; f < CCurveCorpus::NUM_FUNCTIONS; f++)
+        {
+            const CCurveCorpus::eFunction function = static_cast<CCurveCorpus::eFunction>(f);
+            const u64 numRecords = corpus.GetNumRecords(function);
+            CCorpusRun run = {&corpus, function, {0}, {numRecords}};
+
+            const auto start = Clock::now();
+            pool.Run(static_cast<u32>((numRecords + RECORDS_PER_CHUNK - 1) / RECORDS_PER_CHUNK), VerifyChunk, &run);
+            const f64 millis = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+
+            const u64 numMismatches = run.NumMismatches.load();
+            std::printf("  %-28s %llu records %s in %.1f ms\n", CCurveCorpus::GetFunctionName(function),
+                static_cast<unsigned long long>(numRecords), numMismatches ? "FAILED" : "passed", millis);
+            if (numMismatches)
+            {
+                std::printf("    %llu mismatches, first ", static_cast<unsigned long long>(numMismatches));
+                corpus.PrintRecord(stdout, function, run.FirstMismatch.load());
+                bPassed = false;
+            }
+        }
+    }
+
+    return bPassed ? 0 : 1;
+}
@@ -2,8 +2,31 @@ set_languages("cxx23")
 
 add_rules("mode.debug", "mode.release")
 
+-- no FMA contraction (-march=native brings FMA in), the batched kernels, CalcCurvePoint and the inline helpers in
+-- maths.hpp have to round the same way everywhere they're compiled. MSVC doesn't contract without /fp:contract.
+add_cxflags("-ffp-contract=off", {tools = {"gcc", "clang"}})
+
+option("avx2")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the batched curve kernels for AVX2")
+option_end()
+
+option("fast_trig")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build CCurves with the CCurveFast precision policy (polynomial sine/cosine, reciprocal, FMA)")
+option_end()
+
+option("stats")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Count the branches the curve functions take and record their inputs, see CCurveStats")
+option_end()
+
 target("sa-curves-test")
     set_kind("shared")
+    set_enabled(is_plat("windows"))
     set_extension(".asi")
     add_files("src/*.cpp")
 
@@ -11,3 +34,85 @@ target("sa-curves-test")
         os.cp(target:targetfile(), "C:/$Files/Games/GTA SA")
         os.cp(target:symbolfile(), "C:/$Files/Games/GTA SA")
     end)
+
+-- native build of the custom implementation, doesn't need the game
+target("curves")
+    set_kind("static")
+    add_files("src/curve*.cpp")
+    add_headerfiles("src/*.hpp")
+    add_includedirs("src", {public = true})
+    add_defines("USE_CUSTOM_IMPL")
+    add_syslinks("pthread", {public = true})
+    set_policy("build.optimization.lto", true)
+    if has_config("avx2") then
+        add_vectorexts("avx2")
+    end
+    if has_config("fast_trig") then
+        add_defines("USE_FAST_TRIG")
+    end
+    if has_config("stats") then
+        add_defines("CURVES_STATS", {public = true})
+    end
+
+-- TestCurves and randomized property tests without the game, `xmake run curves-tests --count 10000000` for more
+target("curves-tests")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("src/tests.cpp", "tests/run_tests.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- golden data for curves-tests --corpus, from whichever CCurves it's linked against
+target("curves-corpus")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("tests/make_corpus.cpp")
+    set_policy("build.optimization.lto", true)
+
+target("curves-bench")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/bench_curves.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- per-branch timings, --json writes them out and --baseline compares against an earlier --json
+target("curves-branch-bench")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/bench_branches.cpp")
+    set_policy("build.optimization.lto", true)
+
+target("curves-parallel-bench")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/bench_parallel.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- load throughput of CCurveNetwork on a synthetic node file, or --file for a real one
+target("curves-network-bench")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/bench_network.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- frame time percentiles of agents driving a synthetic road network, seeded and the same for every thread count
+target("curves-traffic-bench")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/bench_traffic.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- memory, quantization error and sweep time of CCompactCurve
+target("curves-compact-report")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/compact_report.cpp")
+    set_policy("build.optimization.lto", true)
+
+-- worst-case deviation of the CCurveFast precision policy from CCurveExact
+target("curves-precision")
+    set_kind("binary")
+    add_deps("curves")
+    add_files("bench/precision_report.cpp")
+    if has_config("avx2") then
+        add_vectorexts("avx2")
+    end